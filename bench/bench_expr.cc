@@ -0,0 +1,141 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "calc/arithmetic.h"
+#include "calc/batch.h"
+#include "codec.h"
+#include "runner.h"
+
+using namespace dingodb::expr;
+
+// Columns: int32 id, int64 amount, double ratio, string name, decimal price.
+static const std::vector<Tuple> &GetData() {
+  static const std::vector<Tuple> data = [] {
+    static const size_t ROWS = 4096;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int32_t> id(0, 1999);
+    std::uniform_int_distribution<int64_t> amount(0, 1000000);
+    std::uniform_real_distribution<double> ratio(0.0, 1.0);
+    std::vector<Tuple> data;
+    data.reserve(ROWS);
+    for (size_t i = 0; i < ROWS; ++i) {
+      auto value = amount(gen);
+      data.push_back(Tuple{
+          id(gen),
+          value,
+          ratio(gen),
+          String("name_" + std::to_string(value)),
+          DecimalP(std::to_string(value / 100) + (value % 100 < 10 ? ".0" : ".") + std::to_string(value % 100)),
+      });
+    }
+    return data;
+  }();
+  return data;
+}
+
+static std::vector<Byte> ToBytes(const std::string &code) {
+  std::vector<Byte> buf(code.size() / 2);
+  HexToBytes(buf.data(), code.data(), code.size());
+  return buf;
+}
+
+// $[0] >= 10 && $[0] < 1000
+static const char *const INT_RANGE = "3100110A9201310011E807950152";
+// $[2] > 0.25 && $[2] <= 0.75
+static const char *const DOUBLE_RANGE = "3502153FD000000000000093053502153FE8000000000000940552";
+// UPPER(CONCAT($[3], 'x'))
+static const char *const STRING_FUN = "3703170178F121F123";
+// SUBSTR($[3], 1, 3)
+static const char *const SUBSTR_FUN = "370311011103F12C";
+// $[4] * 1.5 + $[4]
+static const char *const DECIMAL_ARITH = "36041603312E35850636048306";
+// $[1] > 1000L && $[1] < 500000L && $[0] < 1000 && $[2] <= 0.75
+static const char *const COMPOSITE =
+    "320112E8079302320112A0C21E950252"
+    "310011E807950152"
+    "3502153FE8000000000000940552";
+
+static void RunExpr(benchmark::State &state, const char *code) {
+  auto buf = ToBytes(code);
+  Runner runner;
+  runner.Decode(buf.data(), buf.size());
+  const auto &data = GetData();
+  for (auto _ : state) {
+    for (const auto &tuple : data) {
+      runner.BindTuple(&tuple);
+      runner.Run();
+      benchmark::DoNotOptimize(runner.Get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK_CAPTURE(RunExpr, IntRange, INT_RANGE);
+BENCHMARK_CAPTURE(RunExpr, DoubleRange, DOUBLE_RANGE);
+BENCHMARK_CAPTURE(RunExpr, StringFun, STRING_FUN);
+BENCHMARK_CAPTURE(RunExpr, Substr, SUBSTR_FUN);
+BENCHMARK_CAPTURE(RunExpr, DecimalArith, DECIMAL_ARITH);
+BENCHMARK_CAPTURE(RunExpr, Composite, COMPOSITE);
+
+static void DecodeExpr(benchmark::State &state, const char *code) {
+  auto buf = ToBytes(code);
+  for (auto _ : state) {
+    Runner runner;
+    benchmark::DoNotOptimize(runner.Decode(buf.data(), buf.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+
+BENCHMARK_CAPTURE(DecodeExpr, IntRange, INT_RANGE);
+BENCHMARK_CAPTURE(DecodeExpr, DecimalArith, DECIMAL_ARITH);
+BENCHMARK_CAPTURE(DecodeExpr, Composite, COMPOSITE);
+
+template <typename T>
+static T AddWrap(T v0, T v1) {
+  return (T)((std::make_unsigned_t<T>)v0 + (std::make_unsigned_t<T>)v1);
+}
+
+// Batch add of int64 columns, with or without the overflow checks.
+static void AddBatch(benchmark::State &state, bool checked) {
+  const size_t count = state.range(0);
+  std::vector<int64_t> in0(count), in1(count), out(count);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int64_t> value(-1000000, 1000000);
+  for (size_t i = 0; i < count; ++i) {
+    in0[i] = value(gen);
+    in1[i] = value(gen);
+  }
+  std::vector<Byte> validity(BitmapBytes(count));
+  for (auto _ : state) {
+    if (checked) {
+      const Byte *v;
+      benchmark::DoNotOptimize(calc::CheckedBinaryBatch<TYPE_INT64, calc::AddOverflow>(
+          out.data(), validity.data(), &v, in0.data(), nullptr, in1.data(), nullptr, count));
+    } else {
+      benchmark::DoNotOptimize(calc::BinaryBatch<TYPE_INT64, TYPE_INT64, TYPE_INT64, AddWrap>(
+          out.data(), validity.data(), in0.data(), nullptr, in1.data(), nullptr, count));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_CAPTURE(AddBatch, Unchecked, false)->Arg(4096);
+BENCHMARK_CAPTURE(AddBatch, Checked, true)->Arg(4096);
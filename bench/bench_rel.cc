@@ -0,0 +1,178 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "expr/calc/select.h"
+#include "expr/codec.h"
+#include "rel/column_batch.h"
+#include "rel/parallel_runner.h"
+#include "rel/rel_runner.h"
+
+using namespace dingodb::expr;
+using namespace dingodb::rel;
+
+static const size_t ROWS = 16384;
+
+// Columns: int32 key, double value, the keys are in [0, cardinality).
+static std::vector<Tuple> MakeData(int64_t cardinality) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int32_t> key(0, static_cast<int32_t>(cardinality - 1));
+  std::uniform_real_distribution<double> value(0.0, 100.0);
+  std::vector<Tuple> data;
+  data.reserve(ROWS);
+  for (size_t i = 0; i < ROWS; ++i) {
+    data.push_back(Tuple{key(gen), value(gen)});
+  }
+  return data;
+}
+
+static void Decode(RelRunner &rel, const std::string &code) {
+  std::vector<Byte> buf(code.size() / 2);
+  HexToBytes(buf.data(), code.data(), code.size());
+  rel.Decode(buf.data(), buf.size());
+}
+
+static std::vector<const Tuple *> Pointers(const std::vector<Tuple> &data) {
+  std::vector<const Tuple *> pointers;
+  pointers.reserve(data.size());
+  for (const auto &tuple : data) {
+    pointers.push_back(&tuple);
+  }
+  return pointers;
+}
+
+// Put the tuples one by one, as the callers not using batches do.
+static void PutTuples(benchmark::State &state, const char *code) {
+  auto data = MakeData(state.range(0));
+  for (auto _ : state) {
+    RelRunner rel;
+    Decode(rel, code);
+    for (const auto &tuple : data) {
+      auto out = rel.PutTuple(std::make_unique<Tuple>(tuple));
+      benchmark::DoNotOptimize(out);
+    }
+    while (auto out = rel.GetTuple()) {
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+// Put the tuples in a batch and drain the results.
+static void PutBatch(benchmark::State &state, const char *code) {
+  auto data = MakeData(state.range(0));
+  auto pointers = Pointers(data);
+  Batch batch;
+  for (auto _ : state) {
+    RelRunner rel;
+    Decode(rel, code);
+    batch.Reset(pointers.data(), pointers.size());
+    rel.Put(batch);
+    for (rel.Drain(batch, 1024); !batch.Empty(); rel.Drain(batch, 1024)) {
+      benchmark::DoNotOptimize(batch.GetSelection().size());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+// AGG(input, GROUP($[0]), COUNT(), SUM($[1]))
+static const char *const GROUPED_AGG = "7361010002102501";
+// AGG(input, COUNT(), SUM($[1]))
+static const char *const UNGROUPED_AGG = "7402102501";
+// PROJECT(FILTER(input, $[1] > 50.0), $[0], $[1] * 2.0)
+static const char *const FILTER_PROJECT = "7135011540490000000000009305007231003501154000000000000000850500";
+
+BENCHMARK_CAPTURE(PutTuples, GroupedAgg, GROUPED_AGG)->RangeMultiplier(16)->Range(16, 16384);
+BENCHMARK_CAPTURE(PutBatch, GroupedAgg, GROUPED_AGG)->RangeMultiplier(16)->Range(16, 16384);
+BENCHMARK_CAPTURE(PutTuples, UngroupedAgg, UNGROUPED_AGG)->Arg(1);
+BENCHMARK_CAPTURE(PutBatch, UngroupedAgg, UNGROUPED_AGG)->Arg(1);
+BENCHMARK_CAPTURE(PutTuples, FilterProject, FILTER_PROJECT)->Arg(1);
+BENCHMARK_CAPTURE(PutBatch, FilterProject, FILTER_PROJECT)->Arg(1);
+
+// Put 64 column batches of the data by a parallel runner of `range(1)` threads.
+static void PutParallel(benchmark::State &state, const char *code) {
+  static const size_t BATCHES = 64;
+  auto data = MakeData(state.range(0));
+  std::vector<std::unique_ptr<ColumnBatch>> columns;
+  std::vector<const ColumnBatch *> inputs;
+  for (size_t b = 0; b < BATCHES; ++b) {
+    ColumnBatchBuilder builder;
+    for (const auto &tuple : data) {
+      builder.Append(tuple);
+    }
+    struct ArrowSchema schema;
+    struct ArrowArray array;
+    builder.Finish(&schema, &array);
+    columns.emplace_back(new ColumnBatch(&schema, &array));
+    inputs.push_back(columns.back().get());
+  }
+  std::vector<Byte> buf(strlen(code) / 2);
+  HexToBytes(buf.data(), code, strlen(code));
+  Batch batch;
+  for (auto _ : state) {
+    ParallelRunner rel(state.range(1));
+    rel.Decode(buf.data(), buf.size());
+    rel.Put(inputs.data(), inputs.size());
+    for (rel.Drain(batch, 1024); !batch.Empty(); rel.Drain(batch, 1024)) {
+      benchmark::DoNotOptimize(batch.GetSelection().size());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data.size() * BATCHES);
+}
+
+BENCHMARK_CAPTURE(PutParallel, GroupedAgg, GROUPED_AGG)->ArgsProduct({{16, 16384}, {1, 2, 4, 8}})->UseRealTime();
+BENCHMARK_CAPTURE(PutParallel, FilterProject, FILTER_PROJECT)->ArgsProduct({{1}, {1, 2, 4, 8}})->UseRealTime();
+
+// AGG(FILTER(input, $[0] < 8 && $[1] > 50.0), COUNT()), the filter is evaluated over the columns.
+static const char *const SELECT_COUNT = "71310011089501350115404900000000000093055200740110";
+
+// Put a column batch of the data, with the kernels of the filter limited to SIMD level `range(1)`.
+static void PutColumns(benchmark::State &state, const char *code) {
+  auto data = MakeData(state.range(0));
+  ColumnBatchBuilder builder;
+  for (const auto &tuple : data) {
+    builder.Append(tuple);
+  }
+  struct ArrowSchema schema;
+  struct ArrowArray array;
+  builder.Finish(&schema, &array);
+  ColumnBatch columns(&schema, &array);
+  auto level = calc::GetSimdLevel();
+  if (state.range(1) > level) {
+    state.SkipWithError("SIMD level not supported");
+    return;
+  }
+  calc::LimitSimdLevel(static_cast<calc::SimdLevel>(state.range(1)));
+  Batch batch;
+  for (auto _ : state) {
+    RelRunner rel;
+    Decode(rel, code);
+    rel.Put(columns, batch);
+    for (rel.Drain(batch, 1024); !batch.Empty(); rel.Drain(batch, 1024)) {
+      benchmark::DoNotOptimize(batch.GetSelection().size());
+    }
+  }
+  calc::LimitSimdLevel(level);
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK_CAPTURE(PutBatch, SelectCount, SELECT_COUNT)->Arg(16);
+BENCHMARK_CAPTURE(PutColumns, SelectCount, SELECT_COUNT)->ArgsProduct({{16}, {0, 1, 2}});
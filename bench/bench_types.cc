@@ -0,0 +1,106 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "calc/casting.h"
+#include "decimal_p.h"
+
+using namespace dingodb::expr;
+using namespace dingodb::types;
+
+static const std::vector<std::string> &GetNumbers() {
+  static const std::vector<std::string> numbers = [] {
+    std::vector<std::string> numbers;
+    for (int i = 0; i < 1024; ++i) {
+      numbers.push_back(std::to_string(i * 7919 % 100000) + "." + std::to_string(i % 90 + 10));
+    }
+    return numbers;
+  }();
+  return numbers;
+}
+
+template <typename D, typename S>
+static void CastValues(benchmark::State &state, const std::vector<S> &values) {
+  for (auto _ : state) {
+    for (const auto &v : values) {
+      benchmark::DoNotOptimize(calc::Cast<D>(v));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void CastStringToInt64(benchmark::State &state) {
+  std::vector<String> values;
+  for (int i = 0; i < 1024; ++i) {
+    values.emplace_back(std::to_string(i * 7919));
+  }
+  CastValues<int64_t>(state, values);
+}
+
+static void CastStringToDouble(benchmark::State &state) {
+  std::vector<String> values(GetNumbers().begin(), GetNumbers().end());
+  CastValues<double>(state, values);
+}
+
+static void CastDoubleToString(benchmark::State &state) {
+  std::vector<double> values;
+  for (int i = 0; i < 1024; ++i) {
+    values.push_back(i * 0.7919);
+  }
+  CastValues<String>(state, values);
+}
+
+static void CastStringToDecimal(benchmark::State &state) {
+  std::vector<String> values(GetNumbers().begin(), GetNumbers().end());
+  CastValues<DecimalP>(state, values);
+}
+
+static void CastDecimalToDouble(benchmark::State &state) {
+  std::vector<DecimalP> values(GetNumbers().begin(), GetNumbers().end());
+  CastValues<double>(state, values);
+}
+
+static void CastDecimalToString(benchmark::State &state) {
+  std::vector<DecimalP> values(GetNumbers().begin(), GetNumbers().end());
+  CastValues<String>(state, values);
+}
+
+BENCHMARK(CastStringToInt64);
+BENCHMARK(CastStringToDouble);
+BENCHMARK(CastDoubleToString);
+BENCHMARK(CastStringToDecimal);
+BENCHMARK(CastDecimalToDouble);
+BENCHMARK(CastDecimalToString);
+
+template <typename Op>
+static void DecimalArith(benchmark::State &state, Op op) {
+  std::vector<DecimalP> values(GetNumbers().begin(), GetNumbers().end());
+  DecimalP factor(std::string("1.5"));
+  for (auto _ : state) {
+    for (const auto &v : values) {
+      benchmark::DoNotOptimize(op(v, factor));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK_CAPTURE(DecimalArith, Add, [](const DecimalP &a, const DecimalP &b) { return a + b; });
+BENCHMARK_CAPTURE(DecimalArith, Sub, [](const DecimalP &a, const DecimalP &b) { return a - b; });
+BENCHMARK_CAPTURE(DecimalArith, Mul, [](const DecimalP &a, const DecimalP &b) { return a * b; });
+BENCHMARK_CAPTURE(DecimalArith, Div, [](const DecimalP &a, const DecimalP &b) { return a / b; });
+BENCHMARK_CAPTURE(DecimalArith, Compare, [](const DecimalP &a, const DecimalP &b) { return a < b; });
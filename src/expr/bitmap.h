@@ -0,0 +1,145 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _EXPR_BITMAP_H_
+#define _EXPR_BITMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "types.h"
+
+namespace dingodb::expr {
+
+// Bitmaps are in the layout of Apache Arrow, i.e. bit `i` is the `(i % 8)`th least significant bit of byte `i / 8`.
+// A validity bitmap has its bit set for non-null values, and a `nullptr` validity bitmap means no nulls at all.
+
+inline size_t BitmapBytes(size_t count) {
+  return (count + 7) / 8;
+}
+
+inline bool BitmapGet(const Byte *bitmap, size_t i) {
+  return (bitmap[i >> 3] >> (i & 7)) & 1;
+}
+
+inline void BitmapSet(Byte *bitmap, size_t i) {
+  bitmap[i >> 3] |= (Byte)(1 << (i & 7));
+}
+
+inline void BitmapClear(Byte *bitmap, size_t i) {
+  bitmap[i >> 3] &= (Byte)~(1 << (i & 7));
+}
+
+inline void BitmapFill(Byte *bitmap, size_t count, bool value) {
+  memset(bitmap, value ? 0xFF : 0x00, BitmapBytes(count));
+}
+
+inline bool IsValid(const Byte *validity, size_t i) {
+  return validity == nullptr || BitmapGet(validity, i);
+}
+
+/**
+ * @brief Copy a validity bitmap, or set all the bits if the source is `nullptr`.
+ *
+ * @param dst the destination bitmap
+ * @param src the source bitmap
+ * @param count number of bits
+ */
+inline void CopyValidity(Byte *dst, const Byte *src, size_t count) {
+  if (src != nullptr) {
+    memcpy(dst, src, BitmapBytes(count));
+  } else {
+    BitmapFill(dst, count, true);
+  }
+}
+
+/**
+ * @brief Load 64 bits of a bitmap, from bit `64 * word`. Bits beyond `count` are cleared.
+ *
+ * @param bitmap the bitmap
+ * @param word the index of the word
+ * @param count number of bits of the bitmap
+ * @return uint64_t the bits
+ */
+inline uint64_t BitmapWord(const Byte *bitmap, size_t word, size_t count) {
+  size_t begin = word * 64;
+  if (begin + 64 <= count) {
+    uint64_t bits;
+    memcpy(&bits, bitmap + begin / 8, sizeof(bits));
+    return bits;
+  }
+  uint64_t bits = 0;
+  size_t bytes = BitmapBytes(count) - begin / 8;
+  for (size_t i = 0; i < bytes; ++i) {
+    bits |= (uint64_t)bitmap[begin / 8 + i] << (8 * i);
+  }
+  return bits & ((1ULL << (count - begin)) - 1);
+}
+
+/**
+ * @brief Store 64 bits of a bitmap, from bit `64 * word`, the reverse of `BitmapWord`. Bytes beyond `count` bits are
+ * not written.
+ *
+ * @param bitmap the bitmap
+ * @param word the index of the word
+ * @param bits the bits
+ * @param count number of bits of the bitmap
+ */
+inline void BitmapSetWord(Byte *bitmap, size_t word, uint64_t bits, size_t count) {
+  size_t begin = word * 64;
+  if (begin + 64 <= count) {
+    memcpy(bitmap + begin / 8, &bits, sizeof(bits));
+    return;
+  }
+  size_t bytes = BitmapBytes(count) - begin / 8;
+  for (size_t i = 0; i < bytes; ++i) {
+    bitmap[begin / 8 + i] = (Byte)(bits >> (8 * i));
+  }
+}
+
+/**
+ * @brief Combine two validity bitmaps, so a value is valid only if valid in both. Bitmaps are combined word by word,
+ * and no bitmap is written if any of them is `nullptr`.
+ *
+ * @param dst the buffer of the combined bitmap, `(count + 7) / 8` bytes
+ * @param v0 one validity bitmap
+ * @param v1 the other validity bitmap
+ * @param count number of bits
+ * @return const Byte* the combined bitmap, which is `dst`, one of the inputs, or `nullptr` if there are no nulls
+ */
+inline const Byte *AndValidity(Byte *dst, const Byte *v0, const Byte *v1, size_t count) {
+  if (v0 == nullptr) {
+    return v1;
+  }
+  if (v1 == nullptr) {
+    return v0;
+  }
+  size_t bytes = BitmapBytes(count);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t)) {
+    uint64_t w0, w1;
+    memcpy(&w0, v0 + i, sizeof(w0));
+    memcpy(&w1, v1 + i, sizeof(w1));
+    w0 &= w1;
+    memcpy(dst + i, &w0, sizeof(w0));
+  }
+  for (; i < bytes; ++i) {
+    dst[i] = v0[i] & v1[i];
+  }
+  return dst;
+}
+
+}  // namespace dingodb::expr
+
+#endif /* _EXPR_BITMAP_H_ */
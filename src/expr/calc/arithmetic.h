@@ -15,6 +15,8 @@
 #ifndef _EXPR_CALC_ARITHMETIC_H_
 #define _EXPR_CALC_ARITHMETIC_H_
 
+#include <type_traits>
+
 #include "../operand.h"
 
 namespace dingodb::expr::calc {
@@ -53,6 +55,43 @@ T Mul(T v0, T v1) {
 template <>
 long Mul(long v0, long v1);
 
+/**
+ * @brief Add two integers, telling overflow instead of throwing. The flag is returned in the sign bit of a value of the
+ * same type, so the flags of a batch can be OR-ed into a word of the same lanes, which vectorizes where a `bool` or
+ * `__builtin_add_overflow` does not.
+ *
+ * @param v0 the first operand
+ * @param v1 the second operand
+ * @param result the sum, wrapped around on overflow
+ * @return T negative if overflowed
+ */
+template <typename T>
+T AddOverflow(T v0, T v1, T *result) {
+  using U = std::make_unsigned_t<T>;
+  T r = (T)((U)v0 + (U)v1);
+  *result = r;
+  return (v0 ^ r) & (v1 ^ r);
+}
+
+/**
+ * @brief Subtract two integers, telling overflow instead of throwing, the same as `AddOverflow`.
+ */
+template <typename T>
+T SubOverflow(T v0, T v1, T *result) {
+  using U = std::make_unsigned_t<T>;
+  T r = (T)((U)v0 - (U)v1);
+  *result = r;
+  return (v0 ^ v1) & (v0 ^ r);
+}
+
+/**
+ * @brief Multiply two integers, telling overflow instead of throwing, the same as `AddOverflow`.
+ */
+template <typename T>
+T MulOverflow(T v0, T v1, T *result) {
+  return -(T)__builtin_mul_overflow(v0, v1, result);
+}
+
 template <typename T>
 Operand Div(T v0, T v1) {
   if (v1 != 0) {
@@ -0,0 +1,231 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _EXPR_CALC_BATCH_H_
+#define _EXPR_CALC_BATCH_H_
+
+#include <algorithm>
+
+#include "../bitmap.h"
+#include "../hash.h"
+#include "../types.h"
+
+// Kernels evaluating functions over columns of values, with nulls expressed by validity bitmaps (see "bitmap.h")
+// instead of being tested value by value. Values at the null slots of the outputs are zero (default constructed), and
+// those of the inputs are never read.
+
+namespace dingodb::expr::calc {
+
+/**
+ * @brief Visit the rows in words of 64. The rows of a word are passed to `valid` without testing bits if they are all
+ * valid, and to `null` if they are all null, so the loops over them are branch-free and can be vectorized.
+ *
+ * @param validity the validity bitmap, `nullptr` if there are no nulls
+ * @param count number of the rows
+ * @param valid called with the index of each valid row
+ * @param null called with the index of each null row
+ */
+template <typename V, typename N>
+void VisitValidity(const Byte *validity, size_t count, V valid, N null) {
+  if (validity == nullptr) {
+    for (size_t i = 0; i < count; ++i) {
+      valid(i);
+    }
+    return;
+  }
+  for (size_t begin = 0; begin < count; begin += 64) {
+    size_t end = std::min(begin + 64, count);
+    uint64_t bits = BitmapWord(validity, begin / 64, count);
+    uint64_t all = (end - begin == 64) ? ~0ULL : (1ULL << (end - begin)) - 1;
+    if (bits == all) {
+      for (size_t i = begin; i < end; ++i) {
+        valid(i);
+      }
+    } else if (bits == 0) {
+      for (size_t i = begin; i < end; ++i) {
+        null(i);
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        if ((bits >> (i - begin)) & 1) {
+          valid(i);
+        } else {
+          null(i);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Evaluate a unary function over a column. The output has the same validity as the input.
+ *
+ * @param out the output values, `count` elements
+ * @param in the input values
+ * @param validity the validity bitmap of the input, `nullptr` if there are no nulls
+ * @param count number of the values
+ * @return const Byte* the validity bitmap of the output, i.e. `validity`
+ */
+template <Byte R, Byte T, TypeOf<R> (*Calc)(TypeOf<T>)>
+const Byte *UnaryBatch(TypeOf<R> *out, const TypeOf<T> *in, const Byte *validity, size_t count) {
+  VisitValidity(
+      validity, count, [&](size_t i) { out[i] = Calc(in[i]); }, [&](size_t i) { out[i] = TypeOf<R>(); });
+  return validity;
+}
+
+/**
+ * @brief Evaluate a binary function over two columns. The validity bitmaps are combined word-wide, and the function
+ * is evaluated on the valid rows only.
+ *
+ * @param out the output values, `count` elements
+ * @param validity the buffer of the output validity bitmap, `(count + 7) / 8` bytes, written only if both inputs
+ * have nulls
+ * @param in0 the values of the first input
+ * @param validity0 the validity bitmap of the first input, `nullptr` if there are no nulls
+ * @param in1 the values of the second input
+ * @param validity1 the validity bitmap of the second input, `nullptr` if there are no nulls
+ * @param count number of the values
+ * @return const Byte* the validity bitmap of the output, which is `validity`, one of the inputs, or `nullptr` if there
+ * are no nulls
+ */
+template <Byte R, Byte T0, Byte T1, TypeOf<R> (*Calc)(TypeOf<T0>, TypeOf<T1>)>
+const Byte *BinaryBatch(
+    TypeOf<R> *out,
+    Byte *validity,
+    const TypeOf<T0> *in0,
+    const Byte *validity0,
+    const TypeOf<T1> *in1,
+    const Byte *validity1,
+    size_t count) {
+  const auto *v = AndValidity(validity, validity0, validity1, count);
+  VisitValidity(
+      v, count, [&](size_t i) { out[i] = Calc(in0[i], in1[i]); }, [&](size_t i) { out[i] = TypeOf<R>(); });
+  return v;
+}
+
+/**
+ * @brief Evaluate a binary integer function with overflow checking over two columns, the same as `BinaryBatch`. The
+ * function returns a negative value on overflow (see `AddOverflow` in "arithmetic.h"). The flags are OR-ed over all
+ * the rows, or each word of 64 rows if there are nulls, without branching, and only a range with overflow is scanned
+ * again to locate the row, so the error can be raised by the caller out of the inner loop.
+ *
+ * @param out the output values, `count` elements, valid only before the overflowed row
+ * @param validity the buffer of the output validity bitmap, the same as `BinaryBatch`
+ * @param result set to the validity bitmap of the output, the same as the return value of `BinaryBatch`
+ * @param in0 the values of the first input
+ * @param validity0 the validity bitmap of the first input, `nullptr` if there are no nulls
+ * @param in1 the values of the second input
+ * @param validity1 the validity bitmap of the second input, `nullptr` if there are no nulls
+ * @param count number of the values
+ * @return size_t the index of the first overflowed row, or `count` if there is none
+ */
+template <Byte R, TypeOf<R> (*Calc)(TypeOf<R>, TypeOf<R>, TypeOf<R> *)>
+size_t CheckedBinaryBatch(
+    TypeOf<R> *out,
+    Byte *validity,
+    const Byte **result,
+    const TypeOf<R> *in0,
+    const Byte *validity0,
+    const TypeOf<R> *in1,
+    const Byte *validity1,
+    size_t count) {
+  const auto *v = AndValidity(validity, validity0, validity1, count);
+  *result = v;
+  if (v == nullptr) {
+    TypeOf<R> overflow = 0;
+    for (size_t i = 0; i < count; ++i) {
+      overflow |= Calc(in0[i], in1[i], &out[i]);
+    }
+    if (overflow < 0) {
+      TypeOf<R> r;
+      for (size_t i = 0; i < count; ++i) {
+        if (Calc(in0[i], in1[i], &r) < 0) {
+          return i;
+        }
+      }
+    }
+    return count;
+  }
+  for (size_t begin = 0; begin < count; begin += 64) {
+    size_t end = std::min(begin + 64, count);
+    uint64_t all = (end - begin == 64) ? ~0ULL : (1ULL << (end - begin)) - 1;
+    uint64_t bits = BitmapWord(v, begin / 64, count);
+    TypeOf<R> overflow = 0;
+    if (bits == all) {
+      for (size_t i = begin; i < end; ++i) {
+        overflow |= Calc(in0[i], in1[i], &out[i]);
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        if ((bits >> (i - begin)) & 1) {
+          overflow |= Calc(in0[i], in1[i], &out[i]);
+        } else {
+          out[i] = TypeOf<R>();
+        }
+      }
+    }
+    if (overflow < 0) {
+      TypeOf<R> r;
+      for (size_t i = begin; i < end; ++i) {
+        if (((bits >> (i - begin)) & 1) && Calc(in0[i], in1[i], &r) < 0) {
+          return i;
+        }
+      }
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Evaluate a tertiary function over three columns, the same as `BinaryBatch`.
+ */
+template <Byte R, Byte T0, Byte T1, Byte T2, TypeOf<R> (*Calc)(TypeOf<T0>, TypeOf<T1>, TypeOf<T2>)>
+const Byte *TertiaryBatch(
+    TypeOf<R> *out,
+    Byte *validity,
+    const TypeOf<T0> *in0,
+    const Byte *validity0,
+    const TypeOf<T1> *in1,
+    const Byte *validity1,
+    const TypeOf<T2> *in2,
+    const Byte *validity2,
+    size_t count) {
+  const auto *v01 = AndValidity(validity, validity0, validity1, count);
+  const auto *v = AndValidity(validity, v01, validity2, count);
+  VisitValidity(
+      v, count, [&](size_t i) { out[i] = Calc(in0[i], in1[i], in2[i]); }, [&](size_t i) { out[i] = TypeOf<R>(); });
+  return v;
+}
+
+/**
+ * @brief Combine the hashes of a column into those of the rows, so hashing the key columns one by one into hashes
+ * initialized to `HASH_SEED` gives the same as `HashValue` of the key tuples.
+ *
+ * @param hashes the hashes of the rows, `count` elements
+ * @param in the values
+ * @param validity the validity bitmap, `nullptr` if there are no nulls
+ * @param count number of the values
+ */
+template <typename T>
+void HashBatch(uint64_t *hashes, const T *in, const Byte *validity, size_t count) {
+  VisitValidity(
+      validity,
+      count,
+      [&](size_t i) { hashes[i] = HashCombine(hashes[i], HashValue(in[i])); },
+      [&](size_t i) { hashes[i] = HashCombine(hashes[i], HASH_NULL); });
+}
+
+}  // namespace dingodb::expr::calc
+
+#endif /* _EXPR_CALC_BATCH_H_ */
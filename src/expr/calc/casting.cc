@@ -14,11 +14,15 @@
 
 #include "casting.h"
 
+#include <cerrno>
+#include <charconv>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <malloc.h>
 
+#include "../bitmap.h"
 #include "../exception.h"
 
 namespace dingodb::expr::calc {
@@ -1464,6 +1468,198 @@ int d2s_strfromd(char *str, size_t count, int precision, double value)
   return target.failed ? -1 : (target.bufptr - target.bufstart + target.nchars);
 }
 
+// Parsing of numbers from strings. The semantics are the same as `std::stoi`, `std::stof` and the like, i.e. leading
+// spaces and a sign are accepted and parsing stops at the first invalid character, but without the locale and `errno`
+// overhead of the C library.
+
+enum class ParseStatus {
+  OK,
+  INVALID,
+  OUT_OF_RANGE,
+};
+
+static inline bool IsSpaceChar(char ch) {
+  return std::isspace((unsigned char)ch);
+}
+
+static inline bool IsDigitChar(char ch) {
+  return '0' <= ch && ch <= '9';
+}
+
+static inline const char *SkipSpacesAndSign(const char *p, const char *end, bool &negative) {
+  while (p < end && IsSpaceChar(*p)) {
+    ++p;
+  }
+  negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    negative = (*p == '-');
+    ++p;
+  }
+  return p;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// SWAR (SIMD within a register) processing of 8 digits, see https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/
+
+static inline bool IsEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+         0x3333333333333333ULL;
+}
+
+static inline uint32_t ParseEightDigits(uint64_t chunk) {
+  chunk = ((chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+  chunk = ((chunk & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+  return (uint32_t)(((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+}
+#endif
+
+/**
+ * @brief Parse a run of decimal digits, 8 digits a time where possible.
+ *
+ * @param p the start of the digits
+ * @param end the end of the buffer
+ * @param value the magnitude parsed
+ * @param overflow set if the magnitude exceeds 64 bits
+ * @return const char* the first non-digit position
+ */
+static inline const char *ParseDigitRun(const char *p, const char *end, uint64_t &value, bool &overflow) {
+  value = 0;
+  overflow = false;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  while (end - p >= 8 && value <= (UINT64_MAX - 99999999ULL) / 100000000ULL) {
+    uint64_t chunk;
+    memcpy(&chunk, p, sizeof(chunk));
+    if (!IsEightDigits(chunk)) {
+      break;
+    }
+    value = value * 100000000ULL + ParseEightDigits(chunk);
+    p += 8;
+  }
+#endif
+  for (; p < end && IsDigitChar(*p); ++p) {
+    if (!overflow) {
+      overflow = __builtin_mul_overflow(value, 10ULL, &value) || __builtin_add_overflow(value, *p - '0', &value);
+    }
+  }
+  return p;
+}
+
+template <typename T>
+static ParseStatus ParseInteger(std::string_view str, T &value) {
+  const char *end = str.data() + str.size();
+  bool negative;
+  const char *p = SkipSpacesAndSign(str.data(), end, negative);
+  uint64_t magnitude;
+  bool overflow;
+  if (ParseDigitRun(p, end, magnitude, overflow) == p) {
+    return ParseStatus::INVALID;
+  }
+  uint64_t limit = (uint64_t)std::numeric_limits<T>::max() + (negative ? 1 : 0);
+  if (overflow || magnitude > limit) {
+    return ParseStatus::OUT_OF_RANGE;
+  }
+  value = (T)(negative ? 0 - magnitude : magnitude);
+  return ParseStatus::OK;
+}
+
+static inline void StrToFloat(const char *str, char **end, float &value) {
+  value = strtof(str, end);
+}
+
+static inline void StrToFloat(const char *str, char **end, double &value) {
+  value = strtod(str, end);
+}
+
+template <typename T>
+static ParseStatus ParseFloat(std::string_view str, T &value) {
+  const char *end = str.data() + str.size();
+  bool negative;
+  const char *p = SkipSpacesAndSign(str.data(), end, negative);
+  if (p < end && (*p == '+' || *p == '-')) {
+    return ParseStatus::INVALID;
+  }
+  if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    // Hexadecimal floats are rare, leave them to the C library.
+    std::string buf(str);
+    char *e;
+    errno = 0;
+    StrToFloat(buf.c_str(), &e, value);
+    if (e == buf.c_str()) {
+      return ParseStatus::INVALID;
+    }
+    return errno == ERANGE ? ParseStatus::OUT_OF_RANGE : ParseStatus::OK;
+  }
+  auto [ptr, ec] = std::from_chars(p, end, value);
+  if (ec == std::errc::invalid_argument) {
+    return ParseStatus::INVALID;
+  }
+  if (ec == std::errc::result_out_of_range) {
+    return ParseStatus::OUT_OF_RANGE;
+  }
+  if (negative) {
+    value = -value;
+  }
+  return ParseStatus::OK;
+}
+
+static inline ParseStatus ParseNumber(std::string_view str, int32_t &value) {
+  return ParseInteger(str, value);
+}
+
+static inline ParseStatus ParseNumber(std::string_view str, int64_t &value) {
+  return ParseInteger(str, value);
+}
+
+static inline ParseStatus ParseNumber(std::string_view str, float &value) {
+  return ParseFloat(str, value);
+}
+
+static inline ParseStatus ParseNumber(std::string_view str, double &value) {
+  return ParseFloat(str, value);
+}
+
+/**
+ * @brief Cast a string to a number. Invalid strings are cast to 0.
+ *
+ * @tparam B the type of the number
+ * @tparam Check throw `ExceedsLimits` if out of range, else `std::out_of_range` as `std::stoi` and the like do
+ */
+template <Byte B, bool Check>
+static TypeOf<B> CastStringTo(std::string_view str) {
+  TypeOf<B> value;
+  switch (ParseNumber(str, value)) {
+  case ParseStatus::OK:
+    return value;
+  case ParseStatus::INVALID:
+    return 0;
+  default:
+    break;
+  }
+  if constexpr (Check) {
+    throw ExceedsLimits<B>();
+  }
+  throw std::out_of_range(std::string("Cannot cast string to ") + TypeName(B) + ", out of range.");
+}
+
+static DecimalP CastStringToDecimal(std::string_view str) {
+  // Plain integers of no more than 18 digits are exact in a 64 bit integer, so GMP string parsing can be skipped.
+  const char *p = str.data();
+  const char *end = p + str.size();
+  bool negative = (p < end && *p == '-');
+  if (negative) {
+    ++p;
+  }
+  if (end - p <= 18) {
+    uint64_t magnitude;
+    bool overflow;
+    if (p < end && ParseDigitRun(p, end, magnitude, overflow) == end) {
+      return DecimalP((long)(negative ? -(int64_t)magnitude : (int64_t)magnitude));
+    }
+  }
+  return DecimalP(std::string(str));
+}
+
+
 void d2s_internal(char * ascii, double num)
 {
   int ndig = DBL_DIG + extra_float_digits;
@@ -1493,11 +1689,7 @@ int32_t Cast(double v) {
 
 template <>
 int32_t Cast(String v) {
-  try {
-    return std::stoi(*v);
-  } catch (const std::invalid_argument& e) {
-    return 0;
-  }
+  return CastStringTo<TYPE_INT32, false>(v.View());
 }
 
 template <>
@@ -1517,11 +1709,7 @@ int64_t Cast(double v) {
 
 template <>
 int64_t Cast(String v) {
-  try {
-    return std::stoll(*v);
-  } catch (const std::invalid_argument& e) {
-    return 0;
-  }
+  return CastStringTo<TYPE_INT64, false>(v.View());
 }
 
 template <>
@@ -1531,11 +1719,7 @@ int64_t Cast(DecimalP v) {
 
 template <>
 float Cast(String v) {
-  try {
-    return std::stof(*v);
-  } catch (const std::invalid_argument& e) {
-    return 0;
-  }
+  return CastStringTo<TYPE_FLOAT, false>(v.View());
 }
 
 template <>
@@ -1545,11 +1729,7 @@ float Cast(DecimalP v) {
 
 template <>
 double Cast(String v) {
-  try {
-    return std::stod(*v);
-  } catch (const std::invalid_argument& e) {
-    return 0;
-  }
+  return CastStringTo<TYPE_DOUBLE, false>(v.View());
 }
 
 template <>
@@ -1668,7 +1848,7 @@ DecimalP Cast(double v) {
 
 template <>
 DecimalP Cast(String v) {
-  return DecimalP(*v);
+  return CastStringToDecimal(v.View());
 }
 
 template <>
@@ -1734,4 +1914,153 @@ int64_t CastCheck(DecimalP v) {
   return v.toLong();
 }
 
+template <>
+int32_t CastCheck(String v) {
+  return CastStringTo<TYPE_INT32, true>(v.View());
+}
+
+template <>
+int64_t CastCheck(String v) {
+  return CastStringTo<TYPE_INT64, true>(v.View());
+}
+
+template <>
+float CastCheck(String v) {
+  return CastStringTo<TYPE_FLOAT, true>(v.View());
+}
+
+template <>
+double CastCheck(String v) {
+  return CastStringTo<TYPE_DOUBLE, true>(v.View());
+}
+
+template <typename D, D (*Calc)(std::string_view)>
+static void CastStringBatch(
+    D *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CopyValidity(validity, in_validity, count);
+  for (size_t i = 0; i < count; ++i) {
+    if (IsValid(in_validity, i)) {
+      out[i] = Calc(std::string_view(data + offsets[i], offsets[i + 1] - offsets[i]));
+    } else {
+      out[i] = D();
+    }
+  }
+}
+
+template <>
+void CastBatch(
+    int32_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<int32_t, CastStringTo<TYPE_INT32, false>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastBatch(
+    int64_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<int64_t, CastStringTo<TYPE_INT64, false>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastBatch(
+    float *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<float, CastStringTo<TYPE_FLOAT, false>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastBatch(
+    double *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<double, CastStringTo<TYPE_DOUBLE, false>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastBatch(
+    DecimalP *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<DecimalP, CastStringToDecimal>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastCheckBatch(
+    int32_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<int32_t, CastStringTo<TYPE_INT32, true>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastCheckBatch(
+    int64_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<int64_t, CastStringTo<TYPE_INT64, true>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastCheckBatch(
+    float *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<float, CastStringTo<TYPE_FLOAT, true>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastCheckBatch(
+    double *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  CastStringBatch<double, CastStringTo<TYPE_DOUBLE, true>>(out, validity, offsets, data, in_validity, count);
+}
+
+template <>
+void CastCheckBatch(
+    DecimalP *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count) {
+  // There are no limits of decimals to exceed, the same as `CastCheck`.
+  CastStringBatch<DecimalP, CastStringToDecimal>(out, validity, offsets, data, in_validity, count);
+}
+
 }  // namespace dingodb::expr::calc
@@ -101,6 +101,139 @@ template <>
 int64_t CastCheck(float v);
 template <>
 int64_t CastCheck(double v);
+template <>
+int32_t CastCheck(String v);
+template <>
+int64_t CastCheck(String v);
+template <>
+float CastCheck(String v);
+template <>
+double CastCheck(String v);
+
+/**
+ * @brief Cast a column of strings to a column of numbers.
+ *
+ * The strings are in the layout of Apache Arrow, i.e. the `i`th string spans from `data + offsets[i]` to
+ * `data + offsets[i + 1]`. Null strings produce nulls, and invalid strings are cast to 0, as `Cast` does.
+ *
+ * @tparam D the target type, one of `int32_t`, `int64_t`, `float`, `double` and `DecimalP`
+ * @param out the output values, `count` elements
+ * @param validity the output validity bitmap, `(count + 7) / 8` bytes
+ * @param offsets the offsets of the strings, `count + 1` elements
+ * @param data the characters of the strings
+ * @param in_validity the input validity bitmap, `nullptr` if there are no nulls
+ * @param count number of the strings
+ */
+template <typename D>
+void CastBatch(
+    D *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastBatch(
+    int32_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastBatch(
+    int64_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastBatch(
+    float *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastBatch(
+    double *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastBatch(
+    DecimalP *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+/**
+ * @brief The same as `CastBatch`, but throws `ExceedsLimits` if a value is out of range.
+ */
+template <typename D>
+void CastCheckBatch(
+    D *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastCheckBatch(
+    int32_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastCheckBatch(
+    int64_t *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastCheckBatch(
+    float *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastCheckBatch(
+    double *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
+
+template <>
+void CastCheckBatch(
+    DecimalP *out,
+    Byte *validity,
+    const int32_t *offsets,
+    const char *data,
+    const Byte *in_validity,
+    size_t count);
 
 }  // namespace dingodb::expr::calc
 
@@ -0,0 +1,163 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _EXPR_CALC_DATETIME_H_
+#define _EXPR_CALC_DATETIME_H_
+
+#include <cstdint>
+
+// Date and time functions over milliseconds since the epoch (UTC), which is the value of both `TYPE_DATE` and
+// `TYPE_TIMESTAMP`. The civil calendar is computed by integer arithmetic (see
+// http://howardhinnant.github.io/date_algorithms.html) instead of `gmtime`/`mktime`, without branches, so the
+// functions can be inlined into the batch kernels (see "batch.h").
+
+namespace dingodb::expr::calc {
+
+const int64_t MILLIS_PER_SECOND = 1000LL;
+const int64_t MILLIS_PER_MINUTE = 60LL * MILLIS_PER_SECOND;
+const int64_t MILLIS_PER_HOUR = 60LL * MILLIS_PER_MINUTE;
+const int64_t MILLIS_PER_DAY = 24LL * MILLIS_PER_HOUR;
+
+/**
+ * @brief Floor division, i.e. rounding towards negative infinity, for dates before the epoch.
+ */
+inline int64_t FloorDiv(int64_t v, int64_t d) {
+  int64_t q = v / d;
+  return q - ((v % d) < 0);
+}
+
+/**
+ * @brief Days since the epoch of a time.
+ */
+inline int64_t DaysOf(int64_t millis) {
+  return FloorDiv(millis, MILLIS_PER_DAY);
+}
+
+/**
+ * @brief Milliseconds since the start of the day of a time.
+ */
+inline int64_t MillisOfDay(int64_t millis) {
+  return millis - DaysOf(millis) * MILLIS_PER_DAY;
+}
+
+/**
+ * @brief A date of the civil (proleptic Gregorian) calendar.
+ */
+struct CivilDate {
+  int64_t year;
+  int32_t month;
+  int32_t day;
+};
+
+/**
+ * @brief Convert days since the epoch to a civil date.
+ */
+inline CivilDate CivilFromDays(int64_t days) {
+  int64_t z = days + 719468;
+  int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  int64_t doe = z - era * 146097;
+  int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  // Months from March.
+  int64_t mp = (5 * doy + 2) / 153;
+  auto month = static_cast<int32_t>(mp < 10 ? mp + 3 : mp - 9);
+  return {yoe + era * 400 + (month <= 2), month, static_cast<int32_t>(doy - (153 * mp + 2) / 5 + 1)};
+}
+
+/**
+ * @brief Convert a civil date to days since the epoch.
+ */
+inline int64_t DaysFromCivil(int64_t year, int32_t month, int32_t day) {
+  year -= month <= 2;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t yoe = year - era * 400;
+  int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+inline int32_t Year(int64_t millis) {
+  return static_cast<int32_t>(CivilFromDays(DaysOf(millis)).year);
+}
+
+inline int32_t Quarter(int64_t millis) {
+  return (CivilFromDays(DaysOf(millis)).month + 2) / 3;
+}
+
+inline int32_t Month(int64_t millis) {
+  return CivilFromDays(DaysOf(millis)).month;
+}
+
+inline int32_t Day(int64_t millis) {
+  return CivilFromDays(DaysOf(millis)).day;
+}
+
+/**
+ * @brief Day of the week, from 1 (Sunday) to 7 (Saturday). The epoch is a Thursday.
+ */
+inline int32_t DayOfWeek(int64_t millis) {
+  int64_t days = DaysOf(millis) + 4;
+  return static_cast<int32_t>(days - FloorDiv(days, 7) * 7) + 1;
+}
+
+inline int32_t Hour(int64_t millis) {
+  return static_cast<int32_t>(MillisOfDay(millis) / MILLIS_PER_HOUR);
+}
+
+inline int32_t Minute(int64_t millis) {
+  return static_cast<int32_t>(MillisOfDay(millis) / MILLIS_PER_MINUTE % 60);
+}
+
+inline int32_t Second(int64_t millis) {
+  return static_cast<int32_t>(MillisOfDay(millis) / MILLIS_PER_SECOND % 60);
+}
+
+inline int64_t TruncYear(int64_t millis) {
+  return DaysFromCivil(CivilFromDays(DaysOf(millis)).year, 1, 1) * MILLIS_PER_DAY;
+}
+
+inline int64_t TruncQuarter(int64_t millis) {
+  auto date = CivilFromDays(DaysOf(millis));
+  return DaysFromCivil(date.year, (date.month - 1) / 3 * 3 + 1, 1) * MILLIS_PER_DAY;
+}
+
+inline int64_t TruncMonth(int64_t millis) {
+  auto date = CivilFromDays(DaysOf(millis));
+  return DaysFromCivil(date.year, date.month, 1) * MILLIS_PER_DAY;
+}
+
+/**
+ * @brief Truncate to the start of the week, which starts on Monday (ISO 8601).
+ */
+inline int64_t TruncWeek(int64_t millis) {
+  // Days since the Monday before the epoch.
+  int64_t days = DaysOf(millis) + 3;
+  return (FloorDiv(days, 7) * 7 - 3) * MILLIS_PER_DAY;
+}
+
+inline int64_t TruncDay(int64_t millis) {
+  return DaysOf(millis) * MILLIS_PER_DAY;
+}
+
+inline int64_t TruncHour(int64_t millis) {
+  return FloorDiv(millis, MILLIS_PER_HOUR) * MILLIS_PER_HOUR;
+}
+
+inline int64_t TruncMinute(int64_t millis) {
+  return FloorDiv(millis, MILLIS_PER_MINUTE) * MILLIS_PER_MINUTE;
+}
+
+}  // namespace dingodb::expr::calc
+
+#endif /* _EXPR_CALC_DATETIME_H_ */
@@ -22,7 +22,7 @@ namespace dingodb::expr::calc {
 
 template <>
 String Min(String v0, String v1) {
-  return std::min(*v0, *v1);
+  return (v1 < v0) ? v1 : v0;
 }
 
 template <>
@@ -32,7 +32,7 @@ DecimalP Min(DecimalP v0, DecimalP v1) {
 
 template <>
 String Max(String v0, String v1) {
-  return std::max(*v0, *v1);
+  return (v0 < v1) ? v1 : v0;
 }
 
 template <>
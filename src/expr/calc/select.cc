@@ -0,0 +1,341 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "select.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "../bitmap.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define EXPR_SELECT_X86
+#define EXPR_TARGET_AVX2 __attribute__((target("avx2")))
+#define EXPR_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace dingodb::expr::calc {
+
+namespace {
+
+template <CompareOp Op, typename T>
+bool Compare(T v0, T v1) {
+  if constexpr (Op == CMP_EQ) {
+    return v0 == v1;
+  } else if constexpr (Op == CMP_NE) {
+    return v0 != v1;
+  } else if constexpr (Op == CMP_LT) {
+    return v0 < v1;
+  } else if constexpr (Op == CMP_LE) {
+    return v0 <= v1;
+  } else if constexpr (Op == CMP_GT) {
+    return v0 > v1;
+  } else {
+    return v0 >= v1;
+  }
+}
+
+// Compare from row `begin`, which is a multiple of 64, packing 64 results a word.
+template <CompareOp Op, typename T>
+void SelectScalar(Byte *bits, const T *in, T value, size_t begin, size_t count) {
+  for (size_t w = begin; w < count; w += 64) {
+    size_t end = std::min(w + 64, count);
+    uint64_t word = 0;
+    for (size_t i = w; i < end; ++i) {
+      word |= (uint64_t)Compare<Op>(in[i], value) << (i - w);
+    }
+    BitmapSetWord(bits, w / 64, word, count);
+  }
+}
+
+#ifdef EXPR_SELECT_X86
+
+// Integers have only EQ and GT, others are got by swapping the operands or negating.
+template <CompareOp Op, typename A>
+EXPR_TARGET_AVX2 __m256i CompareInt(__m256i v0, __m256i v1) {
+  const __m256i ones = _mm256_set1_epi32(-1);
+  if constexpr (Op == CMP_EQ) {
+    return A::Eq(v0, v1);
+  } else if constexpr (Op == CMP_NE) {
+    return _mm256_xor_si256(A::Eq(v0, v1), ones);
+  } else if constexpr (Op == CMP_GT) {
+    return A::Gt(v0, v1);
+  } else if constexpr (Op == CMP_LE) {
+    return _mm256_xor_si256(A::Gt(v0, v1), ones);
+  } else if constexpr (Op == CMP_LT) {
+    return A::Gt(v1, v0);
+  } else {
+    return _mm256_xor_si256(A::Gt(v1, v0), ones);
+  }
+}
+
+template <CompareOp Op>
+constexpr int FloatPredicate() {
+  if constexpr (Op == CMP_EQ) {
+    return _CMP_EQ_OQ;
+  } else if constexpr (Op == CMP_NE) {
+    return _CMP_NEQ_UQ;
+  } else if constexpr (Op == CMP_LT) {
+    return _CMP_LT_OQ;
+  } else if constexpr (Op == CMP_LE) {
+    return _CMP_LE_OQ;
+  } else if constexpr (Op == CMP_GT) {
+    return _CMP_GT_OQ;
+  } else {
+    return _CMP_GE_OQ;
+  }
+}
+
+template <CompareOp Op>
+constexpr int IntPredicate() {
+  if constexpr (Op == CMP_EQ) {
+    return _MM_CMPINT_EQ;
+  } else if constexpr (Op == CMP_NE) {
+    return _MM_CMPINT_NE;
+  } else if constexpr (Op == CMP_LT) {
+    return _MM_CMPINT_LT;
+  } else if constexpr (Op == CMP_LE) {
+    return _MM_CMPINT_LE;
+  } else if constexpr (Op == CMP_GT) {
+    return _MM_CMPINT_NLE;
+  } else {
+    return _MM_CMPINT_NLT;
+  }
+}
+
+// The bits of a vector of `LANES` comparisons.
+template <CompareOp Op, typename T>
+struct Avx2 {};
+
+template <CompareOp Op>
+struct Avx2<Op, double> {
+  static const size_t LANES = 4;
+
+  EXPR_TARGET_AVX2 static uint64_t Mask(const double *p, __m256d c) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), c, FloatPredicate<Op>()));
+  }
+
+  EXPR_TARGET_AVX2 static __m256d Set(double v) {
+    return _mm256_set1_pd(v);
+  }
+};
+
+template <CompareOp Op>
+struct Avx2<Op, float> {
+  static const size_t LANES = 8;
+
+  EXPR_TARGET_AVX2 static uint64_t Mask(const float *p, __m256 c) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), c, FloatPredicate<Op>()));
+  }
+
+  EXPR_TARGET_AVX2 static __m256 Set(float v) {
+    return _mm256_set1_ps(v);
+  }
+};
+
+template <CompareOp Op>
+struct Avx2<Op, int64_t> {
+  static const size_t LANES = 4;
+
+  EXPR_TARGET_AVX2 static __m256i Eq(__m256i v0, __m256i v1) {
+    return _mm256_cmpeq_epi64(v0, v1);
+  }
+
+  EXPR_TARGET_AVX2 static __m256i Gt(__m256i v0, __m256i v1) {
+    return _mm256_cmpgt_epi64(v0, v1);
+  }
+
+  EXPR_TARGET_AVX2 static uint64_t Mask(const int64_t *p, __m256i c) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    return _mm256_movemask_pd(_mm256_castsi256_pd(CompareInt<Op, Avx2>(v, c)));
+  }
+
+  EXPR_TARGET_AVX2 static __m256i Set(int64_t v) {
+    return _mm256_set1_epi64x(v);
+  }
+};
+
+template <CompareOp Op>
+struct Avx2<Op, int32_t> {
+  static const size_t LANES = 8;
+
+  EXPR_TARGET_AVX2 static __m256i Eq(__m256i v0, __m256i v1) {
+    return _mm256_cmpeq_epi32(v0, v1);
+  }
+
+  EXPR_TARGET_AVX2 static __m256i Gt(__m256i v0, __m256i v1) {
+    return _mm256_cmpgt_epi32(v0, v1);
+  }
+
+  EXPR_TARGET_AVX2 static uint64_t Mask(const int32_t *p, __m256i c) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    return _mm256_movemask_ps(_mm256_castsi256_ps(CompareInt<Op, Avx2>(v, c)));
+  }
+
+  EXPR_TARGET_AVX2 static __m256i Set(int32_t v) {
+    return _mm256_set1_epi32(v);
+  }
+};
+
+template <CompareOp Op, typename T>
+EXPR_TARGET_AVX2 void SelectAvx2(Byte *bits, const T *in, T value, size_t count) {
+  using A = Avx2<Op, T>;
+  auto c = A::Set(value);
+  size_t words = count / 64;
+  for (size_t w = 0; w < words; ++w) {
+    const T *p = in + w * 64;
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += A::LANES) {
+      word |= A::Mask(p + j, c) << j;
+    }
+    memcpy(bits + w * 8, &word, sizeof(word));
+  }
+  SelectScalar<Op>(bits, in, value, words * 64, count);
+}
+
+// Comparisons of AVX-512 produce mask registers directly.
+template <CompareOp Op, typename T>
+struct Avx512 {};
+
+template <CompareOp Op>
+struct Avx512<Op, double> {
+  static const size_t LANES = 8;
+
+  EXPR_TARGET_AVX512 static uint64_t Mask(const double *p, double v) {
+    return _mm512_cmp_pd_mask(_mm512_loadu_pd(p), _mm512_set1_pd(v), FloatPredicate<Op>());
+  }
+};
+
+template <CompareOp Op>
+struct Avx512<Op, float> {
+  static const size_t LANES = 16;
+
+  EXPR_TARGET_AVX512 static uint64_t Mask(const float *p, float v) {
+    return _mm512_cmp_ps_mask(_mm512_loadu_ps(p), _mm512_set1_ps(v), FloatPredicate<Op>());
+  }
+};
+
+template <CompareOp Op>
+struct Avx512<Op, int64_t> {
+  static const size_t LANES = 8;
+
+  EXPR_TARGET_AVX512 static uint64_t Mask(const int64_t *p, int64_t v) {
+    return _mm512_cmp_epi64_mask(_mm512_loadu_si512(p), _mm512_set1_epi64(v), IntPredicate<Op>());
+  }
+};
+
+template <CompareOp Op>
+struct Avx512<Op, int32_t> {
+  static const size_t LANES = 16;
+
+  EXPR_TARGET_AVX512 static uint64_t Mask(const int32_t *p, int32_t v) {
+    return _mm512_cmp_epi32_mask(_mm512_loadu_si512(p), _mm512_set1_epi32(v), IntPredicate<Op>());
+  }
+};
+
+template <CompareOp Op, typename T>
+EXPR_TARGET_AVX512 void SelectAvx512(Byte *bits, const T *in, T value, size_t count) {
+  using A = Avx512<Op, T>;
+  size_t words = count / 64;
+  for (size_t w = 0; w < words; ++w) {
+    const T *p = in + w * 64;
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += A::LANES) {
+      word |= A::Mask(p + j, value) << j;
+    }
+    memcpy(bits + w * 8, &word, sizeof(word));
+  }
+  SelectScalar<Op>(bits, in, value, words * 64, count);
+}
+
+#endif
+
+SimdLevel DetectSimdLevel() {
+#ifdef EXPR_SELECT_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SIMD_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMD_AVX2;
+  }
+#endif
+  return SIMD_NONE;
+}
+
+const SimdLevel SUPPORTED_SIMD_LEVEL = DetectSimdLevel();
+
+std::atomic<SimdLevel> simd_level(SUPPORTED_SIMD_LEVEL);
+
+template <CompareOp Op, typename T>
+void Select(Byte *bits, const T *in, T value, size_t count) {
+#ifdef EXPR_SELECT_X86
+  switch (simd_level.load(std::memory_order_relaxed)) {
+  case SIMD_AVX512:
+    SelectAvx512<Op>(bits, in, value, count);
+    return;
+  case SIMD_AVX2:
+    SelectAvx2<Op>(bits, in, value, count);
+    return;
+  default:
+    break;
+  }
+#endif
+  SelectScalar<Op>(bits, in, value, 0, count);
+}
+
+}  // namespace
+
+SimdLevel GetSimdLevel() {
+  return simd_level.load(std::memory_order_relaxed);
+}
+
+void LimitSimdLevel(SimdLevel level) {
+  simd_level.store(std::min(level, SUPPORTED_SIMD_LEVEL), std::memory_order_relaxed);
+}
+
+template <typename T>
+void SelectBatch(Byte *bits, CompareOp op, const T *in, T value, size_t count) {
+  switch (op) {
+  case CMP_EQ:
+    Select<CMP_EQ>(bits, in, value, count);
+    break;
+  case CMP_NE:
+    Select<CMP_NE>(bits, in, value, count);
+    break;
+  case CMP_LT:
+    Select<CMP_LT>(bits, in, value, count);
+    break;
+  case CMP_LE:
+    Select<CMP_LE>(bits, in, value, count);
+    break;
+  case CMP_GT:
+    Select<CMP_GT>(bits, in, value, count);
+    break;
+  case CMP_GE:
+    Select<CMP_GE>(bits, in, value, count);
+    break;
+  default:
+    break;
+  }
+}
+
+template void SelectBatch<int32_t>(Byte *, CompareOp, const int32_t *, int32_t, size_t);
+template void SelectBatch<int64_t>(Byte *, CompareOp, const int64_t *, int64_t, size_t);
+template void SelectBatch<float>(Byte *, CompareOp, const float *, float, size_t);
+template void SelectBatch<double>(Byte *, CompareOp, const double *, double, size_t);
+
+}  // namespace dingodb::expr::calc
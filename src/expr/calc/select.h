@@ -0,0 +1,94 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _EXPR_CALC_SELECT_H_
+#define _EXPR_CALC_SELECT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../types.h"
+
+// Kernels comparing a column of values with a constant into a bitmap, so conjunctions of such comparisons are combined
+// by bitwise ANDs. AVX-512 or AVX2 is used if supported by the CPU, which is detected once at run time.
+
+namespace dingodb::expr::calc {
+
+/**
+ * @brief Comparisons of a column with a constant, i.e. `column REL constant`.
+ */
+enum CompareOp { CMP_EQ, CMP_NE, CMP_LT, CMP_LE, CMP_GT, CMP_GE, CMP_NONE };
+
+/**
+ * @brief Get the comparison with the operands swapped, i.e. `constant REL column` as `column REL' constant`.
+ *
+ * @param op the comparison
+ * @return CompareOp the comparison swapped
+ */
+constexpr CompareOp SwapCompareOp(CompareOp op) {
+  switch (op) {
+  case CMP_LT:
+    return CMP_GT;
+  case CMP_LE:
+    return CMP_GE;
+  case CMP_GT:
+    return CMP_LT;
+  case CMP_GE:
+    return CMP_LE;
+  default:
+    break;
+  }
+  return op;
+}
+
+/**
+ * @brief Instruction sets of the kernels, in the order of preference.
+ */
+enum SimdLevel { SIMD_NONE, SIMD_AVX2, SIMD_AVX512 };
+
+/**
+ * @brief Get the instruction set used by the kernels.
+ *
+ * @return SimdLevel the best supported by the CPU, or lower if limited by `LimitSimdLevel`
+ */
+SimdLevel GetSimdLevel();
+
+/**
+ * @brief Limit the instruction set used by the kernels, e.g. to compare the results or the speed of them.
+ *
+ * @param level the highest level allowed
+ */
+void LimitSimdLevel(SimdLevel level);
+
+/**
+ * @brief Compare a column of values with a constant into a bitmap, of which bit `i` is set if `in[i] REL value`. The
+ * values of the null rows are compared as well, and are to be masked out by the caller.
+ *
+ * @param bits the output bitmap, `BitmapBytes(count)` bytes
+ * @param op the comparison, not `CMP_NONE`
+ * @param in the values
+ * @param value the constant
+ * @param count number of the values
+ */
+template <typename T>
+void SelectBatch(Byte *bits, CompareOp op, const T *in, T value, size_t count);
+
+extern template void SelectBatch<int32_t>(Byte *, CompareOp, const int32_t *, int32_t, size_t);
+extern template void SelectBatch<int64_t>(Byte *, CompareOp, const int64_t *, int64_t, size_t);
+extern template void SelectBatch<float>(Byte *, CompareOp, const float *, float, size_t);
+extern template void SelectBatch<double>(Byte *, CompareOp, const double *, double, size_t);
+
+}  // namespace dingodb::expr::calc
+
+#endif /* _EXPR_CALC_SELECT_H_ */
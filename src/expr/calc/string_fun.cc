@@ -20,9 +20,9 @@
 namespace dingodb::expr::calc {
 
 String Concat(String v0, String v1) {
-  if (!v0->empty()) {
-    if (!v1->empty()) {
-      return *v0 + *v1;
+  if (!v0.Empty()) {
+    if (!v1.Empty()) {
+      return v0 + v1;
     }
     return v0;
   }
@@ -30,23 +30,25 @@ String Concat(String v0, String v1) {
 }
 
 String Lower(String v) {
-  std::string str(v->length(), '\0');
-  std::transform(v->cbegin(), v->cend(), str.begin(), [](unsigned char ch) { return std::tolower(ch); });
+  auto view = v.View();
+  std::string str(view.length(), '\0');
+  std::transform(view.cbegin(), view.cend(), str.begin(), [](unsigned char ch) { return std::tolower(ch); });
   return str;
 }
 
 String Upper(String v) {
-  std::string str(v->length(), '\0');
-  std::transform(v->cbegin(), v->cend(), str.begin(), [](unsigned char ch) { return std::toupper(ch); });
+  auto view = v.View();
+  std::string str(view.length(), '\0');
+  std::transform(view.cbegin(), view.cend(), str.begin(), [](unsigned char ch) { return std::toupper(ch); });
   return str;
 }
 
 String Left(String v0, int32_t v1) {
-  if (!v0->empty()) {
+  if (!v0.Empty()) {
     if (v1 > 0) {
-      auto len = v0->length();
+      auto len = v0.Length();
       if (v1 < len) {
-        return v0->substr(0, v1);
+        return v0.Slice(0, v1);
       }
       return v0;
     }
@@ -56,11 +58,11 @@ String Left(String v0, int32_t v1) {
 }
 
 String Right(String v0, int32_t v1) {
-  if (!v0->empty()) {
+  if (!v0.Empty()) {
     if (v1 > 0) {
-      auto len = v0->length();
+      auto len = v0.Length();
       if (v1 < len) {
-        return v0->substr(len - v1);
+        return v0.Slice(len - v1);
       }
       return v0;
     }
@@ -74,23 +76,26 @@ static bool IsSpace(unsigned char ch) {
 }
 
 String Trim(String v) {
-  auto s = std::find_if_not(v->cbegin(), v->cend(), IsSpace);
-  auto e = std::find_if_not(v->crbegin(), v->crend(), IsSpace);
-  return v->substr(s - v->cbegin(), (v->crend() - e) - (s - v->cbegin()));
+  auto view = v.View();
+  auto s = std::find_if_not(view.cbegin(), view.cend(), IsSpace);
+  auto e = std::find_if_not(view.crbegin(), view.crend(), IsSpace);
+  return v.Slice(s - view.cbegin(), (view.crend() - e) - (s - view.cbegin()));
 }
 
 String LTrim(String v) {
-  auto s = std::find_if_not(v->cbegin(), v->cend(), IsSpace);
-  return v->substr(s - v->cbegin());
+  auto view = v.View();
+  auto s = std::find_if_not(view.cbegin(), view.cend(), IsSpace);
+  return v.Slice(s - view.cbegin());
 }
 
 String RTrim(String v) {
-  auto e = std::find_if_not(v->crbegin(), v->crend(), IsSpace);
-  return v->substr(0, v->crend() - e);
+  auto view = v.View();
+  auto e = std::find_if_not(view.crbegin(), view.crend(), IsSpace);
+  return v.Slice(0, view.crend() - e);
 }
 
 String Substr(String v0, int32_t v1, int32_t v2) {
-  int len = v0->length();
+  int len = v0.Length();
   if (v1 < 0) {
     v1 = 0;
   }
@@ -98,26 +103,26 @@ String Substr(String v0, int32_t v1, int32_t v2) {
     if (v2 >= len) {
       return v0;
     } else {
-      return v0->substr(v1, v2 - v1);
+      return v0.Slice(v1, v2 - v1);
     }
   } else {
     if (v2 >= len) {
-      return v0->substr(v1);
+      return v0.Slice(v1);
     } else {
-      return v0->substr(v1, v2 - v1);
+      return v0.Slice(v1, v2 - v1);
     }
   }
 }
 
 String Substr(String v0, int32_t v1) {
-  int len = v0->length();
+  int len = v0.Length();
   if (v1 < 0) {
     v1 = 0;
   }
   if (v1 == 0) {
     return v0;
   } else {
-    return v0->substr(v1);
+    return v0.Slice(v1);
   }
 }
 
@@ -127,7 +132,7 @@ int Instr(String v0, String v1) {
 
 String Mid(String v0, int32_t v1, int32_t v2) {
   if (v2 > 0) {
-    int len = v0->length();
+    int len = v0.Length();
     if (0 < v1 && v1 <= len) {
       v1 -= 1;
     } else if (-len <= v1 && v1 < 0) {
@@ -136,16 +141,16 @@ String Mid(String v0, int32_t v1, int32_t v2) {
       return String();
     }
     if (v1 + v2 >= len) {
-      return v0->substr(v1);
+      return v0.Slice(v1);
     } else {
-      return v0->substr(v1, v2);
+      return v0.Slice(v1, v2);
     }
   }
   return String();
 }
 
 String Mid(String v0, int32_t v1) {
-  int len = v0->length();
+  int len = v0.Length();
   if (0 < v1 && v1 <= len) {
     v1 -= 1;
   } else if (-len <= v1 && v1 < 0) {
@@ -153,7 +158,7 @@ String Mid(String v0, int32_t v1) {
   } else {
     return String();
   }
-  return v0->substr(v1);
+  return v0.Slice(v1);
 }
 
 }  // namespace dingodb::expr::calc
@@ -46,6 +46,24 @@ class UnknownCode : public ExprError {
   }
 };
 
+class StackUnderflow : public ExprError {
+ public:
+  StackUnderflow(size_t pos, const std::string &op, int required, size_t actual)
+      : ExprError(
+            "Operator #" + std::to_string(pos) + " (" + op + ") requires " + std::to_string(required) +
+            " operands, but only " + std::to_string(actual) + " on the stack.") {
+  }
+};
+
+class OperandTypeMismatch : public ExprError {
+ public:
+  OperandTypeMismatch(size_t pos, const std::string &op, int index, Byte expected, Byte actual)
+      : ExprError(
+            "Operand " + std::to_string(index) + " of operator #" + std::to_string(pos) + " (" + op + ") must be " +
+            TypeName(expected) + ", but is " + TypeName(actual) + ".") {
+  }
+};
+
 class MoreElementsRequired : public ExprError {
  public:
   MoreElementsRequired(int required, int actual)
@@ -11,81 +11,181 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
-
 #ifndef _EXPR_EXPR_STRING_H_
 #define _EXPR_EXPR_STRING_H_
 
+#include <cstdint>
 #include <memory>
 #include <ostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+
+#include "hash.h"
 
 namespace dingodb::expr {
 
 /**
  * @brief Type to hold a string.
  *
+ * A `String` may be a slice, i.e. a range of characters in a buffer shared with its owner, which is the `std::string`
+ * of its parent or any other object holding the characters, e.g. an imported Arrow array, so that substring functions
+ * and column readers need not copy characters. Comparing and hashing work on the slice directly, and `View` reads the
+ * characters of any string without copying. The underlying `std::string` is accessed by `operator*` and `operator->`
+ * only for a string which is not a slice. A slice is copied only explicitly, by `GetPtr` or `Detached`, so a `String` is
+ * never mutated by reading it.
  */
 class String {
  public:
   using ValueType = std::shared_ptr<std::string>;
 
-  String(const std::shared_ptr<std::string> &ptr) : m_ptr(ptr) {
+  String(const std::shared_ptr<std::string> &ptr) : m_owner(ptr), m_data(nullptr), m_length(WHOLE) {
+  }
+
+  String(const std::string &str) : m_owner(std::make_shared<std::string>(str)), m_data(nullptr), m_length(WHOLE) {
   }
 
-  String(const std::string &str) : m_ptr(std::make_shared<std::string>(str)) {
+  String(std::string &&str)
+      : m_owner(std::make_shared<std::string>(std::move(str))), m_data(nullptr), m_length(WHOLE) {
   }
 
-  String(const char *str) : m_ptr(std::make_shared<std::string>(str)) {
+  String(const char *str) : m_owner(std::make_shared<std::string>(str)), m_data(nullptr), m_length(WHOLE) {
   }
 
-  String(const char *str, size_t len) : m_ptr(std::make_shared<std::string>(str, len)) {
+  String(const char *str, size_t len)
+      : m_owner(std::make_shared<std::string>(str, len)), m_data(nullptr), m_length(WHOLE) {
   }
 
-  String() : m_ptr(std::make_shared<std::string>()) {
+  String() : m_owner(std::make_shared<std::string>()), m_data(nullptr), m_length(WHOLE) {
   }
 
+  /**
+   * @brief Construct a slice of characters held by another object, without copying.
+   *
+   * @param owner the object holding the characters, kept alive by the slice
+   * @param data the characters
+   * @param len number of the characters
+   */
+  String(std::shared_ptr<void> owner, const char *data, size_t len)
+      : m_owner(std::move(owner)), m_data(data), m_length(len) {
+  }
+
+  /**
+   * @brief Get the underlying `std::string`.
+   *
+   * @return ValueType the owner of this string, or a detached copy of the characters if it is a slice
+   */
   ValueType GetPtr() const {
-    return m_ptr;
+    if (m_length == WHOLE) {
+      return std::static_pointer_cast<std::string>(m_owner);
+    }
+    return std::make_shared<std::string>(View());
   }
 
+  // Not for a slice, of which there is no `std::string` to refer to. Use `View` instead.
   const std::string &operator*() const {
-    return *m_ptr;
+    return *Whole();
   }
 
+  // Not for a slice, of which there is no `std::string` to refer to. Use `View` instead.
   const std::string *operator->() const {
-    return &*m_ptr;
+    return Whole();
+  }
+
+  /**
+   * @brief Get the characters of the string without copying.
+   *
+   * @return std::string_view the view, valid as long as this object is alive
+   */
+  std::string_view View() const {
+    if (m_length == WHOLE) {
+      return *static_cast<const std::string *>(m_owner.get());
+    }
+    return std::string_view(m_data, m_length);
+  }
+
+  size_t Length() const {
+    return m_length == WHOLE ? static_cast<const std::string *>(m_owner.get())->length() : m_length;
+  }
+
+  bool Empty() const {
+    return Length() == 0;
+  }
+
+  bool IsSlice() const {
+    return m_length != WHOLE;
+  }
+
+  /**
+   * @brief Make a slice sharing the buffer of this string, with the same semantics as `std::string::substr`.
+   *
+   * @param pos position of the first character
+   * @param len length of the slice, clamped to the end of the string
+   * @return String the slice
+   */
+  String Slice(size_t pos, size_t len = std::string::npos) const {
+    auto size = Length();
+    if (pos > size) {
+      throw std::out_of_range("String::Slice: pos (which is " + std::to_string(pos) + ") > size (which is " +
+                              std::to_string(size) + ")");
+    }
+    if (len > size - pos) {
+      len = size - pos;
+    }
+    if (len == size) {
+      return *this;
+    }
+    return String(m_owner, View().data() + pos, len);
+  }
+
+  /**
+   * @brief Get a string not sharing the buffer of a slice, for a value kept longer than its owner is wanted, e.g. a
+   * grouping key read from a column batch.
+   *
+   * @return String this string if it is not a slice, or a copy of the characters
+   */
+  String Detached() const {
+    if (m_length == WHOLE) {
+      return *this;
+    }
+    return String(std::string(View()));
   }
 
   String operator+(const String &v) const {
-    return *m_ptr + *v.m_ptr;
+    auto v0 = View();
+    auto v1 = v.View();
+    std::string str;
+    str.reserve(v0.length() + v1.length());
+    str.append(v0).append(v1);
+    return String(std::move(str));
   }
 
   bool operator==(const String &v) const {
-    return *m_ptr == *v.m_ptr;
+    return View() == v.View();
   }
 
   bool operator!=(const String &v) const {
-    return *m_ptr != *v.m_ptr;
+    return View() != v.View();
   }
 
   bool operator<(const String &v) const {
-    return *m_ptr < *v.m_ptr;
+    return View() < v.View();
   }
 
   bool operator<=(const String &v) const {
-    return *m_ptr <= *v.m_ptr;
+    return View() <= v.View();
   }
 
   bool operator>(const String &v) const {
-    return *m_ptr > *v.m_ptr;
+    return View() > v.View();
   }
 
   bool operator>=(const String &v) const {
-    return *m_ptr >= *v.m_ptr;
+    return View() >= v.View();
   }
 
   int find(const String &v) const {
-    std::size_t found = (*m_ptr).find(*v.GetPtr());
+    std::size_t found = View().find(v.View());
     if (found != std::string::npos) {
       return found + 1;
     } else {
@@ -96,13 +196,31 @@ class String {
   }
 
  private:
-  ValueType m_ptr;
+  // The length of a string which is not a slice, i.e. the owner is a `std::string` and covers all of it.
+  static constexpr size_t WHOLE = SIZE_MAX;
+
+  std::shared_ptr<void> m_owner;
+  // The characters of a slice, unused if not a slice.
+  const char *m_data;
+  size_t m_length;
+
+  const std::string *Whole() const {
+    if (m_length != WHOLE) {
+      throw std::logic_error("String: a slice has no underlying std::string, use View() or GetPtr().");
+    }
+    return static_cast<const std::string *>(m_owner.get());
+  }
 
   friend class Operand;
 
   friend std::ostream &operator<<(std::ostream &os, const String &v);
 };
 
+inline uint64_t HashValue(const String &v) {
+  auto view = v.View();
+  return HashBytes(view.data(), view.size());
+}
+
 }  // namespace dingodb::expr
 
 namespace std {
@@ -110,7 +228,7 @@ namespace std {
 template <>
 struct hash<::dingodb::expr::String> {
   size_t operator()(const ::dingodb::expr::String &val) const noexcept {
-    return hash<std::string>()(*val);
+    return ::dingodb::expr::HashValue(val);
   }
 };
 
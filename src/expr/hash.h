@@ -0,0 +1,157 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _EXPR_HASH_H_
+#define _EXPR_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Non-cryptographic hashing of values, tuples and columns, in the construction of wyhash
+// (https://github.com/wangyi-fudan/wyhash): a 64x64->128 bit multiplication folded by xor mixes 64 bits at a time.
+// Fixed-width values take a single multiplication, so `std::hash` of integers no longer leaves the low bits of
+// sequential keys clustered.
+
+namespace dingodb::expr {
+
+const uint64_t HASH_SEED = 0xa0761d6478bd642fULL;
+const uint64_t HASH_P1 = 0xe7037ed1a0b428dbULL;
+const uint64_t HASH_P2 = 0x8ebc6af09c88c6e3ULL;
+const uint64_t HASH_P3 = 0x589965cc75374cc3ULL;
+
+// Hash of `NULL`.
+const uint64_t HASH_NULL = 0x1d8e4e27c47d124fULL;
+
+/**
+ * @brief Multiply two 64-bit numbers, leaving the low and high halves of the product in `a` and `b`.
+ */
+inline void HashMum(uint64_t &a, uint64_t &b) {
+  unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  a = static_cast<uint64_t>(r);
+  b = static_cast<uint64_t>(r >> 64);
+}
+
+inline uint64_t HashMix(uint64_t a, uint64_t b) {
+  HashMum(a, b);
+  return a ^ b;
+}
+
+/**
+ * @brief Hash a 64-bit fixed-width value.
+ */
+inline uint64_t HashInt(uint64_t v, uint64_t seed = HASH_SEED) {
+  return HashMix(v ^ HASH_P1, seed ^ HASH_P2);
+}
+
+/**
+ * @brief Combine the hash of a value into that of the preceding values, e.g. for a tuple or several key columns.
+ */
+inline uint64_t HashCombine(uint64_t h, uint64_t v) {
+  return HashMix(h ^ HASH_P3, v ^ HASH_P1);
+}
+
+inline uint64_t HashRead8(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t HashRead4(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ * @brief Hash a sequence of bytes. Short ones (up to 16 bytes) are read by at most 4 overlapping loads without
+ * loops, longer ones in three independent lanes of 16 bytes.
+ *
+ * @param data the bytes
+ * @param len number of the bytes
+ * @param seed the seed
+ * @return uint64_t the hash
+ */
+inline uint64_t HashBytes(const void *data, size_t len, uint64_t seed = HASH_SEED) {
+  const auto *p = static_cast<const uint8_t *>(data);
+  seed ^= HashMix(seed ^ HASH_SEED, HASH_P1);
+  uint64_t a;
+  uint64_t b;
+  if (len <= 16) {
+    if (len >= 4) {
+      size_t d = (len >> 3) << 2;
+      a = (HashRead4(p) << 32) | HashRead4(p + d);
+      b = (HashRead4(p + len - 4) << 32) | HashRead4(p + len - 4 - d);
+    } else if (len > 0) {
+      a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (i > 48) {
+      uint64_t seed1 = seed;
+      uint64_t seed2 = seed;
+      do {
+        seed = HashMix(HashRead8(p) ^ HASH_P1, HashRead8(p + 8) ^ seed);
+        seed1 = HashMix(HashRead8(p + 16) ^ HASH_P2, HashRead8(p + 24) ^ seed1);
+        seed2 = HashMix(HashRead8(p + 32) ^ HASH_P3, HashRead8(p + 40) ^ seed2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (i > 16) {
+      seed = HashMix(HashRead8(p) ^ HASH_P1, HashRead8(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+    a = HashRead8(p + i - 16);
+    b = HashRead8(p + i - 8);
+  }
+  a ^= HASH_P1;
+  b ^= seed;
+  HashMum(a, b);
+  return HashMix(a ^ HASH_SEED ^ len, b ^ HASH_P1);
+}
+
+// Type-specialized hashing of fixed-width values. Values equal by `==` have equal hashes.
+
+inline uint64_t HashValue(int32_t v) {
+  return HashInt(static_cast<uint64_t>(static_cast<int64_t>(v)));
+}
+
+inline uint64_t HashValue(int64_t v) {
+  return HashInt(static_cast<uint64_t>(v));
+}
+
+inline uint64_t HashValue(bool v) {
+  return HashInt(v ? 1 : 0);
+}
+
+inline uint64_t HashValue(double v) {
+  // `-0.0 == 0.0`.
+  v = (v == 0.0 ? 0.0 : v);
+  uint64_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  return HashInt(bits);
+}
+
+inline uint64_t HashValue(float v) {
+  return HashValue(static_cast<double>(v));
+}
+
+}  // namespace dingodb::expr
+
+#endif /* _EXPR_HASH_H_ */
@@ -38,6 +38,39 @@ std::ostream &operator<<(std::ostream &os, const Operand &v) {
   }
   return os;
 }
+
+Byte Operand::GetType() const {
+  if (std::holds_alternative<int32_t>(m_data)) {
+    return TYPE_INT32;
+  } else if (std::holds_alternative<int64_t>(m_data)) {
+    return TYPE_INT64;
+  } else if (std::holds_alternative<bool>(m_data)) {
+    return TYPE_BOOL;
+  } else if (std::holds_alternative<float>(m_data)) {
+    return TYPE_FLOAT;
+  } else if (std::holds_alternative<double>(m_data)) {
+    return TYPE_DOUBLE;
+  } else if (std::holds_alternative<String>(m_data)) {
+    return TYPE_STRING;
+  } else if (std::holds_alternative<DecimalP>(m_data)) {
+    return TYPE_DECIMAL;
+  }
+  return TYPE_NULL;
+}
+
+uint64_t HashValue(const DecimalP &v) {
+  auto str = v.ToString();
+  auto dot = str.find('.');
+  if (dot != std::string::npos) {
+    auto end = str.find_last_not_of('0');
+    str.resize(end == dot ? dot : end + 1);
+  }
+  if (str == "-0") {
+    str = "0";
+  }
+  return HashBytes(str.data(), str.size());
+}
+
 namespace any_optional_data_adaptor {
 
 template <>
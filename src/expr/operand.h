@@ -16,11 +16,14 @@
 #define _EXPR_OPERAND_H_
 
 #include <any>
+#include <functional>
 #include <optional>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "hash.h"
 #include "types.h"
 #include "decimal_p.h"
 
@@ -84,6 +87,13 @@ class Operand {
     return std::holds_alternative<bool>(m_data);
   }
 
+  /**
+   * @brief Get the type of the value held, `TYPE_NULL` for `NULL`. Dates and timestamps are reported as `TYPE_INT64`.
+   *
+   * @return Byte the type
+   */
+  Byte GetType() const;
+
   template <typename T>
   T GetInteriorValue() const {
     return std::get<T>(m_data);
@@ -108,13 +118,58 @@ class Operand {
       std::shared_ptr<std::vector<DecimalP>>>
       m_data;
 
-  friend class std::hash<::dingodb::expr::Operand>;
+  friend uint64_t HashValue(const Operand &v);
 
   friend std::ostream &operator<<(std::ostream &os, const Operand &v);
 };
 
 using Tuple = std::vector<Operand>;
 
+/**
+ * @brief Hash a decimal by its string with trailing zeros of the fraction removed, for decimals are equal if their
+ * strings are equal as numbers.
+ */
+uint64_t HashValue(const DecimalP &v);
+
+/**
+ * @brief Hash an operand by the type-specialized hashing of the value held.
+ */
+inline uint64_t HashValue(const Operand &v) {
+  const auto &data = v.m_data;
+  switch (data.index()) {
+  case 0:
+    return HASH_NULL;
+  case 1:
+    return HashValue(std::get<1>(data));
+  case 2:
+    return HashValue(std::get<2>(data));
+  case 3:
+    return HashValue(std::get<3>(data));
+  case 4:
+    return HashValue(std::get<4>(data));
+  case 5:
+    return HashValue(std::get<5>(data));
+  case 6:
+    return HashValue(std::get<6>(data));
+  case 7:
+    return HashValue(std::get<7>(data));
+  default:
+    // Arrays are hashed by identity, as compared.
+    return std::hash<std::remove_const_t<std::remove_reference_t<decltype(data)>>>()(data);
+  }
+}
+
+/**
+ * @brief Hash a tuple by combining the hashes of its values.
+ */
+inline uint64_t HashValue(const Tuple &v) {
+  uint64_t h = HASH_SEED;
+  for (const auto &e : v) {
+    h = HashCombine(h, HashValue(e));
+  }
+  return h;
+}
+
 namespace any_optional_data_adaptor {
 
 template <typename T>
@@ -170,19 +225,14 @@ namespace std {
 template <>
 struct hash<::dingodb::expr::Operand> {
   size_t operator()(const ::dingodb::expr::Operand &val) const noexcept {
-    return hash<decltype(val.m_data)>()(val.m_data);
+    return ::dingodb::expr::HashValue(val);
   }
 };
 
 template <>
 struct hash<::dingodb::expr::Tuple> {
   size_t operator()(const ::dingodb::expr::Tuple &val) const noexcept {
-    size_t h = 0LL;
-    for (const auto &v : val) {
-      h *= 31LL;
-      h += hash<::dingodb::expr::Operand>()(v);
-    }
-    return h;
+    return ::dingodb::expr::HashValue(val);
   }
 };
 
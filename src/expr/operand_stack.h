@@ -15,16 +15,18 @@
 #ifndef _OPERAND_STACK_H_
 #define _OPERAND_STACK_H_
 
-#include <deque>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
 
 #include "operand.h"
+#include "row_source.h"
 
 namespace dingodb::expr {
 
 class OperandStack {
  public:
-  OperandStack() : m_tuple(nullptr) {
+  OperandStack() : m_tuple(nullptr), m_row(nullptr) {
   }
 
   virtual ~OperandStack() = default;
@@ -37,6 +39,10 @@ class OperandStack {
     return m_stack.back();
   }
 
+  const Operand &Top() const {
+    return m_stack.back();
+  }
+
   void Push(const Operand &v) {
     m_stack.push_back(v);
   }
@@ -53,20 +59,62 @@ class OperandStack {
 
   void BindTuple(const Tuple *tuple) {
     m_tuple = tuple;
+    m_row = nullptr;
   }
 
-  void PushVar(int32_t index) {
+  void BindRow(const RowSource *row) {
+    m_tuple = nullptr;
+    m_row = row;
+  }
+
+  const Operand &GetVar(int32_t index) const {
     if (m_tuple != nullptr) {
-      m_stack.push_back((*m_tuple)[index]);
-    } else {
-      throw std::runtime_error("No tuple provided.");
+      return (*m_tuple)[index];
+    } else if (m_row != nullptr) {
+      return m_row->Get(index);
     }
+    throw std::runtime_error("No tuple provided.");
+  }
+
+  void PushVar(int32_t index) {
+    m_stack.push_back(GetVar(index));
   }
 
   void Clear() {
     m_stack.clear();
   }
 
+  /**
+   * @brief Move all the values to a tuple, reusing its storage, and clear the stack.
+   *
+   * @param tuple the tuple
+   */
+  void MoveTo(Tuple &tuple) {
+    tuple.assign(std::make_move_iterator(m_stack.begin()), std::make_move_iterator(m_stack.end()));
+    m_stack.clear();
+  }
+
+  /**
+   * @brief Reserve the storage of the stack, so it is never reallocated in running a verified program.
+   *
+   * @param depth the max depth of the stack
+   */
+  void Reserve(size_t depth) {
+    m_stack.reserve(depth);
+  }
+
+  void ResizeTemps(size_t size) {
+    m_temps.resize(size);
+  }
+
+  void StoreTemp(size_t slot) {
+    m_temps[slot] = m_stack.back();
+  }
+
+  void PushTemp(size_t slot) {
+    m_stack.push_back(m_temps[slot]);
+  }
+
   size_t Size() const {
     return m_stack.size();
   }
@@ -82,8 +130,11 @@ class OperandStack {
   }
 
  private:
-  std::deque<Operand> m_stack;
+  std::vector<Operand> m_stack;
   const Tuple *m_tuple;
+  const RowSource *m_row;
+  // Temporary slots for common subexpressions.
+  std::vector<Operand> m_temps;
 };
 
 }  // namespace dingodb::expr
@@ -14,10 +14,41 @@
 
 #include "operator.h"
 
+#include <cxxabi.h>
+
+#include <cstdlib>
+#include <memory>
+
 #include "calc/special.h"
 
 namespace dingodb::expr {
 
+static void EraseAll(std::string &str, const std::string &sub) {
+  for (auto pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos)) {
+    str.erase(pos, sub.size());
+  }
+}
+
+std::string Operator::Describe() const {
+  const char *mangled = typeid(*this).name();
+  int status = 0;
+  std::unique_ptr<char, decltype(&std::free)> demangled(abi::__cxa_demangle(mangled, nullptr, nullptr, &status),
+                                                        &std::free);
+  std::string name = (status == 0 ? demangled.get() : mangled);
+  EraseAll(name, "dingodb::expr::");
+  EraseAll(name, "dingodb::types::");
+  // Type bytes in template arguments are shown by type names.
+  static const std::string TYPE_PREFIX = "(unsigned char)";
+  for (auto pos = name.find(TYPE_PREFIX); pos != std::string::npos; pos = name.find(TYPE_PREFIX, pos)) {
+    auto end = name.find_first_not_of("0123456789", pos + TYPE_PREFIX.size());
+    auto type = std::stoi(name.substr(pos + TYPE_PREFIX.size(), end - pos - TYPE_PREFIX.size()));
+    std::string type_name = TypeName(static_cast<Byte>(type));
+    name.replace(pos, end - pos, type_name);
+    pos += type_name.size();
+  }
+  return name;
+}
+
 void NotOperator::operator()(OperandStack &stack) const {
   auto v = stack.Get();
   stack.Pop();
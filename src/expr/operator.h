@@ -15,9 +15,14 @@
 #ifndef _EXPR_OPERATOR_H_
 #define _EXPR_OPERATOR_H_
 
+#include <cstring>
 #include <functional>
+#include <sstream>
+#include <string>
+#include <type_traits>
 
 #include "calc/casting.h"
+#include "calc/select.h"
 #include "operand_stack.h"
 
 namespace dingodb::expr {
@@ -29,8 +34,88 @@ class Operator {
   virtual void operator()(OperandStack &stack) const = 0;
 
   virtual Byte GetType() const = 0;
+
+  /**
+   * @brief Get the number of operands popped from the stack.
+   *
+   * @return int the number of operands
+   */
+  virtual int Arity() const = 0;
+
+  /**
+   * @brief Get the type of an operand, for verifying.
+   *
+   * @param index the index of the operand, from 0 to `Arity() - 1`, the last one is on the top of the stack
+   * @return Byte the type, or `TYPE_NULL` if any type is accepted
+   */
+  virtual Byte GetOperandType([[maybe_unused]] int index) const {
+    return TYPE_NULL;
+  }
+
+  /**
+   * @brief Check if this operator always produces the same result as another one, given the same operands.
+   *
+   * @param op the other operator
+   * @return true if they are the same
+   */
+  virtual bool IsSameAs(const Operator *op) const {
+    return this == op;
+  }
+
+  /**
+   * @brief Get the index of the variable if the operator just pushes a variable.
+   *
+   * @return int32_t the index, or -1 if the operator is not a plain variable
+   */
+  virtual int32_t GetVarIndex() const {
+    return -1;
+  }
+
+  /**
+   * @brief Get the variable compared with a constant, if the operator is such a comparison of a fixed-width type,
+   * which can be evaluated over a column by `SelectBatch`.
+   *
+   * @param type set to the type of the variable
+   * @return int32_t the index of the variable, or -1 if the operator is not such a comparison
+   */
+  virtual int32_t GetSelectVar([[maybe_unused]] Byte &type) const {
+    return -1;
+  }
+
+  /**
+   * @brief Evaluate the comparison over a column of the variable got by `GetSelectVar` (see `calc::SelectBatch`).
+   *
+   * @param bits the output bitmap, bit set where the comparison is true, regardless of nulls
+   * @param values the values of the column, of the type got by `GetSelectVar`
+   * @param count number of the values
+   */
+  virtual void SelectBatch(
+      [[maybe_unused]] Byte *bits,
+      [[maybe_unused]] const void *values,
+      [[maybe_unused]] size_t count
+  ) const {
+  }
+
+  /**
+   * @brief Get a readable description of the operator, for disassembly.
+   *
+   * @return std::string the description, which is the class name by default
+   */
+  virtual std::string Describe() const;
 };
 
+/**
+ * @brief Compare two values for identity, so `-0.0` and `0.0` are different, and `NaN`s with the same bits are equal.
+ */
+template <typename T>
+bool IsIdentical(const T &v0, const T &v1) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return memcmp(&v0, &v1, sizeof(T)) == 0;
+  } else {
+    return v0 == v1;
+  }
+}
+
 template <Byte R>
 class OperatorBase : public Operator {
  public:
@@ -42,6 +127,14 @@ class OperatorBase : public Operator {
 template <Byte R>
 class NullOperator : public OperatorBase<R> {
  public:
+  int Arity() const override {
+    return 0;
+  }
+
+  std::string Describe() const override {
+    return std::string("NULL ") + TypeName(R);
+  }
+
   void operator()(OperandStack &stack) const override {
     stack.Push<TypeOf<R>>();
   }
@@ -53,10 +146,29 @@ class ConstOperator : public OperatorBase<R> {
   ConstOperator(TypeOf<R> value) : m_value(value) {
   }
 
+  int Arity() const override {
+    return 0;
+  }
+
+  bool IsSameAs(const Operator *op) const override {
+    const auto *c = dynamic_cast<const ConstOperator<R> *>(op);
+    return c != nullptr && IsIdentical(m_value, c->m_value);
+  }
+
   void operator()(OperandStack &stack) const override {
     stack.Push(m_value);
   }
 
+  const TypeOf<R> &GetValue() const {
+    return m_value;
+  }
+
+  std::string Describe() const override {
+    std::ostringstream os;
+    os << "CONST " << TypeName(R) << " " << Operand(m_value);
+    return os.str();
+  }
+
  private:
   TypeOf<R> m_value;
 };
@@ -66,9 +178,17 @@ class ConstBoolOperator : public OperatorBase<TYPE_BOOL> {
  public:
   ConstBoolOperator() = default;
 
+  int Arity() const override {
+    return 0;
+  }
+
   void operator()(OperandStack &stack) const override {
     stack.Push(V);
   }
+
+  std::string Describe() const override {
+    return V ? "CONST BOOL true" : "CONST BOOL false";
+  }
 };
 
 template <Byte R>
@@ -77,10 +197,31 @@ class IndexedVarOperator : public OperatorBase<R> {
   IndexedVarOperator(int32_t index) : m_index(index) {
   }
 
+  int Arity() const override {
+    return 0;
+  }
+
+  bool IsSameAs(const Operator *op) const override {
+    const auto *var = dynamic_cast<const IndexedVarOperator<R> *>(op);
+    return var != nullptr && m_index == var->m_index;
+  }
+
   void operator()(OperandStack &stack) const override {
     stack.PushVar(m_index);
   }
 
+  int32_t GetIndex() const {
+    return m_index;
+  }
+
+  int32_t GetVarIndex() const override {
+    return m_index;
+  }
+
+  std::string Describe() const override {
+    return std::string("VAR ") + TypeName(R) + " $[" + std::to_string(m_index) + "]";
+  }
+
  private:
   int32_t m_index;
 };
@@ -88,6 +229,14 @@ class IndexedVarOperator : public OperatorBase<R> {
 template <Byte R, Byte T, TypeOf<R> (*Calc)(TypeOf<T>)>
 class UnaryOperator : public OperatorBase<R> {
  public:
+  int Arity() const override {
+    return 1;
+  }
+
+  Byte GetOperandType([[maybe_unused]] int index) const override {
+    return T;
+  }
+
   void operator()(OperandStack &stack) const override {
     auto v = stack.Get();
     stack.Pop();
@@ -111,6 +260,10 @@ using UnaryArithmeticOperator = UnaryOperator<R, R, Calc>;
 template <bool (*Calc)(const Operand &)>
 class UnarySpecialOperator : public OperatorBase<TYPE_BOOL> {
  public:
+  int Arity() const override {
+    return 1;
+  }
+
   void operator()(OperandStack &stack) const override {
     auto v = stack.Get();
     stack.Pop();
@@ -121,6 +274,14 @@ class UnarySpecialOperator : public OperatorBase<TYPE_BOOL> {
 template <Byte R, Byte T0, Byte T1, TypeOf<R> (*Calc)(TypeOf<T0>, TypeOf<T1>)>
 class BinaryOperator : public OperatorBase<R> {
  public:
+  int Arity() const override {
+    return 2;
+  }
+
+  Byte GetOperandType(int index) const override {
+    return index == 0 ? T0 : T1;
+  }
+
   void operator()(OperandStack &stack) const override {
     auto v1 = stack.Get();
     stack.Pop();
@@ -137,6 +298,10 @@ class BinaryOperator : public OperatorBase<R> {
 template <Byte R, Byte T0, Byte T1, Operand (*Calc)(TypeOf<T0>, TypeOf<T1>)>
 class BinaryOperatorV2 : public OperatorBase<R> {
  public:
+  int Arity() const override {
+    return 2;
+  }
+
   void operator()(OperandStack &stack) const override {
     auto v1 = stack.Get();
     stack.Pop();
@@ -182,6 +347,14 @@ using BinaryRelationOperator = BinaryOperator<TYPE_BOOL, T, T, Calc>;
 template <Byte R, Byte T0, Byte T1, Byte T2, TypeOf<R> (*Calc)(TypeOf<T0>, TypeOf<T1>, TypeOf<T2>)>
 class TertiaryOperator : public OperatorBase<R> {
  public:
+  int Arity() const override {
+    return 3;
+  }
+
+  Byte GetOperandType(int index) const override {
+    return index == 0 ? T0 : (index == 1 ? T1 : T2);
+  }
+
   void operator()(OperandStack &stack) const override {
     auto v2 = stack.Get();
     stack.Pop();
@@ -197,18 +370,166 @@ class TertiaryOperator : public OperatorBase<R> {
   }
 };
 
+/**
+ * @brief Fused operator comparing a variable with a constant, equivalent to `VAR CONST REL` (or `CONST VAR REL` if
+ * `VarFirst` is false), but without pushing and popping the operands. `Op` is the comparison `Calc` does, of the
+ * operands in the order of `Calc`, or `CMP_NONE` if not to be selected in batches.
+ */
+template <Byte T, bool (*Calc)(TypeOf<T>, TypeOf<T>), calc::CompareOp Op, bool VarFirst>
+class VarConstRelationOperator : public OperatorBase<TYPE_BOOL> {
+ public:
+  VarConstRelationOperator(int32_t index, const TypeOf<T> &value) : m_index(index), m_value(value) {
+  }
+
+  int Arity() const override {
+    return 0;
+  }
+
+  bool IsSameAs(const Operator *op) const override {
+    const auto *o = dynamic_cast<const VarConstRelationOperator<T, Calc, Op, VarFirst> *>(op);
+    return o != nullptr && m_index == o->m_index && IsIdentical(m_value, o->m_value);
+  }
+
+  void operator()(OperandStack &stack) const override {
+    const auto &v = stack.GetVar(m_index);
+    if (v != nullptr) {
+      if constexpr (VarFirst) {
+        stack.Push(Calc(v.GetValue<TypeOf<T>>(), m_value));
+      } else {
+        stack.Push(Calc(m_value, v.GetValue<TypeOf<T>>()));
+      }
+    } else {
+      stack.Push<bool>();
+    }
+  }
+
+  int32_t GetSelectVar(Byte &type) const override {
+    if constexpr (SELECTABLE) {
+      type = T;
+      return m_index;
+    }
+    return -1;
+  }
+
+  void SelectBatch(Byte *bits, const void *values, size_t count) const override {
+    if constexpr (SELECTABLE) {
+      calc::SelectBatch(bits, COMPARE_OP, static_cast<const TypeOf<T> *>(values), m_value, count);
+    }
+  }
+
+  std::string Describe() const override {
+    std::ostringstream os;
+    os << Operator::Describe() << " $[" << m_index << "], " << Operand(m_value);
+    return os.str();
+  }
+
+ private:
+  static constexpr calc::CompareOp COMPARE_OP = VarFirst ? Op : calc::SwapCompareOp(Op);
+  static constexpr bool SELECTABLE =
+      std::is_arithmetic_v<TypeOf<T>> && !std::is_same_v<TypeOf<T>, bool> && COMPARE_OP != calc::CMP_NONE;
+
+  int32_t m_index;
+  TypeOf<T> m_value;
+};
+
+/**
+ * @brief Store the value on the top of the stack to a temporary slot, without popping it.
+ */
+class StoreTempOperator : public Operator {
+ public:
+  StoreTempOperator(size_t slot, Byte type) : m_slot(slot), m_type(type) {
+  }
+
+  void operator()(OperandStack &stack) const override {
+    stack.StoreTemp(m_slot);
+  }
+
+  std::string Describe() const override {
+    return "STORE_TEMP #" + std::to_string(m_slot);
+  }
+
+  Byte GetType() const override {
+    return m_type;
+  }
+
+  int Arity() const override {
+    return 1;
+  }
+
+  Byte GetOperandType([[maybe_unused]] int index) const override {
+    return m_type;
+  }
+
+ private:
+  size_t m_slot;
+  Byte m_type;
+};
+
+/**
+ * @brief Push the value of a temporary slot.
+ */
+class LoadTempOperator : public Operator {
+ public:
+  LoadTempOperator(size_t slot, Byte type) : m_slot(slot), m_type(type) {
+  }
+
+  void operator()(OperandStack &stack) const override {
+    stack.PushTemp(m_slot);
+  }
+
+  std::string Describe() const override {
+    return "LOAD_TEMP #" + std::to_string(m_slot);
+  }
+
+  Byte GetType() const override {
+    return m_type;
+  }
+
+  int Arity() const override {
+    return 0;
+  }
+
+ private:
+  size_t m_slot;
+  Byte m_type;
+};
+
 class NotOperator : public OperatorBase<TYPE_BOOL> {
  public:
+  int Arity() const override {
+    return 1;
+  }
+
+  Byte GetOperandType([[maybe_unused]] int index) const override {
+    return TYPE_BOOL;
+  }
+
   void operator()(OperandStack &stack) const override;
 };
 
 class AndOperator : public OperatorBase<TYPE_BOOL> {
  public:
+  int Arity() const override {
+    return 2;
+  }
+
+  Byte GetOperandType([[maybe_unused]] int index) const override {
+    return TYPE_BOOL;
+  }
+
   void operator()(OperandStack &stack) const override;
 };
 
 class OrOperator : public OperatorBase<TYPE_BOOL> {
  public:
+  int Arity() const override {
+    return 2;
+  }
+
+  Byte GetOperandType([[maybe_unused]] int index) const override {
+    return TYPE_BOOL;
+  }
+
   void operator()(OperandStack &stack) const override;
 };
 
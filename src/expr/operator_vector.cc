@@ -14,8 +14,12 @@
 
 #include "operator_vector.h"
 
+#include <algorithm>
+#include <cstdint>
+
 #include "codec.h"
 #include "exception.h"
+#include "calc/relational.h"
 #include "operators.h"
 #include "types.h"
 #include "utils.h"
@@ -94,6 +98,66 @@ static const Byte FUN    = 0xF1;
 
 static const Byte EOE = 0x00;
 
+template <Byte T, bool (*Calc)(TypeOf<T>, TypeOf<T>), calc::CompareOp Op>
+static const Operator *FuseVarConstRelation(const Operator *op0, const Operator *op1) {
+  const auto *var = dynamic_cast<const IndexedVarOperator<T> *>(op0);
+  const auto *c = dynamic_cast<const ConstOperator<T> *>(op1);
+  if (var != nullptr && c != nullptr) {
+    return new VarConstRelationOperator<T, Calc, Op, true>(var->GetIndex(), c->GetValue());
+  }
+  c = dynamic_cast<const ConstOperator<T> *>(op0);
+  var = dynamic_cast<const IndexedVarOperator<T> *>(op1);
+  if (c != nullptr && var != nullptr) {
+    return new VarConstRelationOperator<T, Calc, Op, false>(var->GetIndex(), c->GetValue());
+  }
+  return nullptr;
+}
+
+template <Byte T>
+static const Operator *FuseVarConstRelation(Byte rel, const Operator *op0, const Operator *op1) {
+  switch (rel) {
+  case EQ:
+    return FuseVarConstRelation<T, calc::Eq<TypeOf<T>>, calc::CMP_EQ>(op0, op1);
+  case GE:
+    return FuseVarConstRelation<T, calc::Ge<TypeOf<T>>, calc::CMP_GE>(op0, op1);
+  case GT:
+    return FuseVarConstRelation<T, calc::Gt<TypeOf<T>>, calc::CMP_GT>(op0, op1);
+  case LE:
+    return FuseVarConstRelation<T, calc::Le<TypeOf<T>>, calc::CMP_LE>(op0, op1);
+  case LT:
+    return FuseVarConstRelation<T, calc::Lt<TypeOf<T>>, calc::CMP_LT>(op0, op1);
+  case NE:
+    return FuseVarConstRelation<T, calc::Ne<TypeOf<T>>, calc::CMP_NE>(op0, op1);
+  default:
+    break;
+  }
+  return nullptr;
+}
+
+static const Operator *FuseVarConstRelation(Byte rel, Byte type, const Operator *op0, const Operator *op1) {
+  switch (type) {
+  case TYPE_INT32:
+    return FuseVarConstRelation<TYPE_INT32>(rel, op0, op1);
+  case TYPE_INT64:
+    return FuseVarConstRelation<TYPE_INT64>(rel, op0, op1);
+  case TYPE_FLOAT:
+    return FuseVarConstRelation<TYPE_FLOAT>(rel, op0, op1);
+  case TYPE_DOUBLE:
+    return FuseVarConstRelation<TYPE_DOUBLE>(rel, op0, op1);
+  case TYPE_DECIMAL:
+    return FuseVarConstRelation<TYPE_DECIMAL>(rel, op0, op1);
+  case TYPE_STRING:
+    return FuseVarConstRelation<TYPE_STRING>(rel, op0, op1);
+  case TYPE_DATE:
+    return FuseVarConstRelation<TYPE_DATE>(rel, op0, op1);
+  case TYPE_TIMESTAMP:
+    return FuseVarConstRelation<TYPE_TIMESTAMP>(rel, op0, op1);
+  default:
+    break;
+  }
+  return nullptr;
+}
+
 const Byte *OperatorVector::Decode(const Byte code[], size_t len) {
   Release();
   bool successful = true;
@@ -220,63 +284,63 @@ const Byte *OperatorVector::Decode(const Byte code[], size_t len) {
       ++p;
       int32_t v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_INT32>(v));
+      AddVar<TYPE_INT32>(v);
       break;
     }
     case VAR_I_INT64: {
       ++p;
       int32_t v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_INT64>(v));
+      AddVar<TYPE_INT64>(v);
       break;
     }
     case VAR_I_BOOL: {
       ++p;
       int32_t v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_BOOL>(v));
+      AddVar<TYPE_BOOL>(v);
       break;
     }
     case VAR_I_FLOAT: {
       ++p;
       int32_t v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_FLOAT>(v));
+      AddVar<TYPE_FLOAT>(v);
       break;
     }
     case VAR_I_DOUBLE: {
       ++p;
       int32_t v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_DOUBLE>(v));
+      AddVar<TYPE_DOUBLE>(v);
       break;
     }
     case VAR_I_DECIMAL: {
       ++p;
       int32_t v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_DECIMAL>(v));
+      AddVar<TYPE_DECIMAL>(v);
       break;
     }
     case VAR_I_STRING: {
       ++p;
       int32_t v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_STRING>(v));
+      AddVar<TYPE_STRING>(v);
       break;
     }
     case VAR_I_DATE: {
       ++p;
       Date v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_DATE>(v));
+      AddVar<TYPE_DATE>(v);
       break;
     }
     case VAR_I_TIMESTAMP: {
       ++p;
       Timestamp v;
       p = DecodeValue(v, p);
-      AddRelease(new IndexedVarOperator<TYPE_TIMESTAMP>(v));
+      AddVar<TYPE_TIMESTAMP>(v);
       break;
     }
     case POS:
@@ -316,32 +380,32 @@ const Byte *OperatorVector::Decode(const Byte code[], size_t len) {
       break;
     case EQ:
       ++p;
-      successful = AddOperatorByType(OP_EQ, *p);
+      successful = AddRelationOperator(OP_EQ, EQ, *p);
       ++p;
       break;
     case GE:
       ++p;
-      successful = AddOperatorByType(OP_GE, *p);
+      successful = AddRelationOperator(OP_GE, GE, *p);
       ++p;
       break;
     case GT:
       ++p;
-      successful = AddOperatorByType(OP_GT, *p);
+      successful = AddRelationOperator(OP_GT, GT, *p);
       ++p;
       break;
     case LE:
       ++p;
-      successful = AddOperatorByType(OP_LE, *p);
+      successful = AddRelationOperator(OP_LE, LE, *p);
       ++p;
       break;
     case LT:
       ++p;
-      successful = AddOperatorByType(OP_LT, *p);
+      successful = AddRelationOperator(OP_LT, LT, *p);
       ++p;
       break;
     case NE:
       ++p;
-      successful = AddOperatorByType(OP_NE, *p);
+      successful = AddRelationOperator(OP_NE, NE, *p);
       ++p;
       break;
     case IS_NULL:
@@ -416,11 +480,209 @@ const Byte *OperatorVector::Decode(const Byte code[], size_t len) {
   }
 eoe:
   if (successful) {
+    Verify();
+    EliminateCommonSubexpressions();
     return p;
   }
   throw UnknownCode(b, len - (b - code));
 }
 
+// Types are compatible if their values are stored as the same C++ type.
+static bool IsCompatible(Byte required, Byte actual) {
+  auto storage = [](Byte type) {
+    return (type == TYPE_DATE || type == TYPE_TIMESTAMP) ? TYPE_INT64 : type;
+  };
+  return required == TYPE_NULL || actual == TYPE_NULL || storage(required) == storage(actual);
+}
+
+void OperatorVector::Verify() {
+  std::vector<Byte> types;
+  for (size_t pos = 0; pos < m_vector.size(); ++pos) {
+    const auto *op = m_vector[pos];
+    auto arity = static_cast<size_t>(op->Arity());
+    if (types.size() < arity) {
+      throw StackUnderflow(pos, op->Describe(), op->Arity(), types.size());
+    }
+    auto base = types.size() - arity;
+    for (size_t i = 0; i < arity; ++i) {
+      auto required = op->GetOperandType(static_cast<int>(i));
+      if (!IsCompatible(required, types[base + i])) {
+        throw OperandTypeMismatch(pos, op->Describe(), static_cast<int>(i), required, types[base + i]);
+      }
+    }
+    types.resize(base);
+    types.push_back(op->GetType());
+    m_max_depth = std::max(m_max_depth, types.size());
+  }
+}
+
+namespace {
+
+// A node of the expression tree, built from the operators in postfix.
+struct Node {
+  const Operator *op;
+  std::vector<size_t> children;
+  // Index of the first identical node.
+  size_t canonical;
+};
+
+class CseEmitter {
+ public:
+  CseEmitter(const std::vector<Node> &nodes, const std::vector<bool> &candidates)
+      : m_nodes(nodes), m_candidates(candidates), m_slots(nodes.size(), NONE), m_loaded(nodes.size(), false) {
+  }
+
+  void Emit(size_t i) {
+    const auto &node = m_nodes[i];
+    size_t c = node.canonical;
+    if (m_slots[c] != NONE) {
+      m_loaded[c] = true;
+      m_ops.push_back(new LoadTempOperator(m_slots[c], node.op->GetType()));
+      return;
+    }
+    for (auto child : node.children) {
+      Emit(child);
+    }
+    m_ops.push_back(node.op);
+    if (m_candidates[c]) {
+      m_slots[c] = m_slot_count++;
+      m_ops.push_back(new StoreTempOperator(m_slots[c], node.op->GetType()));
+    }
+  }
+
+  const std::vector<const Operator *> &GetOps() const {
+    return m_ops;
+  }
+
+  const std::vector<bool> &GetLoaded() const {
+    return m_loaded;
+  }
+
+  size_t GetSlotCount() const {
+    return m_slot_count;
+  }
+
+  bool IsNew(const Operator *op) const {
+    return dynamic_cast<const LoadTempOperator *>(op) != nullptr || dynamic_cast<const StoreTempOperator *>(op) != nullptr;
+  }
+
+ private:
+  static constexpr size_t NONE = SIZE_MAX;
+
+  const std::vector<Node> &m_nodes;
+  const std::vector<bool> &m_candidates;
+  std::vector<size_t> m_slots;
+  std::vector<bool> m_loaded;
+  std::vector<const Operator *> m_ops;
+  size_t m_slot_count = 0;
+};
+
+}  // namespace
+
+void OperatorVector::EliminateCommonSubexpressions() {
+  std::vector<Node> nodes;
+  std::vector<size_t> stack;
+  std::vector<int> counts;
+  nodes.reserve(m_vector.size());
+  for (const auto *op : m_vector) {
+    int arity = op->Arity();
+    if (stack.size() < (size_t)arity) {
+      return;
+    }
+    Node node{op, std::vector<size_t>(stack.end() - arity, stack.end()), nodes.size()};
+    stack.resize(stack.size() - arity);
+    // Only a node of the same operator and the same (canonical) children is identical.
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      const auto &n = nodes[i];
+      if (n.canonical != i || n.children.size() != node.children.size() || !n.op->IsSameAs(op)) {
+        continue;
+      }
+      bool same = true;
+      for (size_t j = 0; j < n.children.size(); ++j) {
+        if (nodes[n.children[j]].canonical != nodes[node.children[j]].canonical) {
+          same = false;
+          break;
+        }
+      }
+      if (same) {
+        node.canonical = i;
+        break;
+      }
+    }
+    stack.push_back(nodes.size());
+    counts.push_back(0);
+    ++counts[node.canonical];
+    nodes.push_back(std::move(node));
+  }
+  // Leaves are as cheap as loading from the slots.
+  std::vector<bool> candidates(nodes.size(), false);
+  bool found = false;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (counts[i] > 1 && !nodes[i].children.empty()) {
+      candidates[i] = true;
+      found = true;
+    }
+  }
+  if (!found) {
+    return;
+  }
+  // A subexpression inside a reused one may never be loaded, so find out what are really loaded by a trial run.
+  CseEmitter trial(nodes, candidates);
+  for (auto root : stack) {
+    trial.Emit(root);
+  }
+  for (const auto *op : trial.GetOps()) {
+    if (trial.IsNew(op)) {
+      delete op;
+    }
+  }
+  candidates = trial.GetLoaded();
+  CseEmitter emitter(nodes, candidates);
+  for (auto root : stack) {
+    emitter.Emit(root);
+  }
+  for (const auto *op : emitter.GetOps()) {
+    if (emitter.IsNew(op)) {
+      m_to_release.push_back(op);
+    }
+  }
+  m_vector = emitter.GetOps();
+  m_temp_count = emitter.GetSlotCount();
+}
+
+std::vector<int32_t> OperatorVector::RemovePassThroughs() {
+  // Start position and variable index of each expression on the stack.
+  std::vector<std::pair<size_t, int32_t>> roots;
+  for (size_t i = 0; i < m_vector.size(); ++i) {
+    const auto *op = m_vector[i];
+    int arity = op->Arity();
+    if (roots.size() < (size_t)arity) {
+      return std::vector<int32_t>(roots.size(), -1);
+    }
+    size_t start = i;
+    if (arity > 0) {
+      start = roots[roots.size() - arity].first;
+      roots.resize(roots.size() - arity);
+    }
+    roots.emplace_back(start, arity == 0 ? op->GetVarIndex() : -1);
+  }
+  std::vector<int32_t> indices;
+  std::vector<const Operator *> ops;
+  for (const auto &root : roots) {
+    indices.push_back(root.second);
+    if (root.second >= 0) {
+      m_vector[root.first] = nullptr;
+    }
+  }
+  for (const auto *op : m_vector) {
+    if (op != nullptr) {
+      ops.push_back(op);
+    }
+  }
+  m_vector.swap(ops);
+  return indices;
+}
+
 bool OperatorVector::AddOperatorByType(const Operator *const ops[], Byte type) {
   const auto *op = ops[type];
   if (op != nullptr) {
@@ -430,6 +692,48 @@ bool OperatorVector::AddOperatorByType(const Operator *const ops[], Byte type) {
   return false;
 }
 
+bool OperatorVector::AddRelationOperator(const Operator *const ops[], Byte rel, Byte type) {
+  if (type >= TYPE_NUM) {
+    return false;
+  }
+  // Both the operands are pushed by the last two operators, if they are leaves, which are released on their own.
+  size_t size = m_vector.size();
+  size_t released = m_to_release.size();
+  if (size >= 2 && released >= 2 && m_vector[size - 2] == m_to_release[released - 2] &&
+      m_vector[size - 1] == m_to_release[released - 1]) {
+    const auto *op = FuseVarConstRelation(rel, type, m_vector[size - 2], m_vector[size - 1]);
+    if (op != nullptr) {
+      delete m_to_release[released - 1];
+      delete m_to_release[released - 2];
+      m_to_release.resize(released - 2);
+      m_vector.resize(size - 2);
+      AddRelease(op);
+      return true;
+    }
+  }
+  return AddOperatorByType(ops, type);
+}
+
+std::vector<const Operator *> OperatorVector::GetSelectConjuncts() const {
+  std::vector<const Operator *> conjuncts;
+  size_t ands = 0;
+  for (const auto *op : m_vector) {
+    Byte type;
+    if (op == OP_AND) {
+      ++ands;
+    } else if (op->GetSelectVar(type) >= 0) {
+      conjuncts.push_back(op);
+    } else {
+      return {};
+    }
+  }
+  // A single expression.
+  if (conjuncts.size() != ands + 1) {
+    return {};
+  }
+  return conjuncts;
+}
+
 bool OperatorVector::AddCastOperator(const Operator *const ops[][TYPE_NUM], Byte b) {
   Byte dst = (Byte)(b >> 4);
   Byte src = (Byte)(b & 0x0F);
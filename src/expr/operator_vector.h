@@ -21,6 +21,35 @@
 
 namespace dingodb::expr {
 
+/**
+ * @brief A variable read by an expression.
+ */
+struct VarInfo {
+  int32_t index;
+  // `TYPE_NULL` if the type is not determined.
+  Byte type;
+
+  bool operator==(const VarInfo &v) const {
+    return index == v.index && type == v.type;
+  }
+};
+
+/**
+ * @brief Add a variable to a list if it is not there, so the list is in the order of first use.
+ *
+ * @param vars the list
+ * @param index the index of the variable
+ * @param type the type of the variable
+ */
+inline void AddVarInfo(std::vector<VarInfo> &vars, int32_t index, Byte type) {
+  for (const auto &var : vars) {
+    if (var.index == index) {
+      return;
+    }
+  }
+  vars.push_back({index, type});
+}
+
 class OperatorVector {
  public:
   OperatorVector() = default;
@@ -35,6 +64,52 @@ class OperatorVector {
     return m_vector.back()->GetType();
   }
 
+  /**
+   * @brief Remove the expressions which are plain variables. Each expression is a root of the postfix operators.
+   *
+   * @return std::vector<int32_t> for each expression, the index of the variable, or -1 if it is not removed
+   */
+  std::vector<int32_t> RemovePassThroughs();
+
+  /**
+   * @brief Get the number of temporary slots required to run the operators.
+   *
+   * @return size_t the number of slots
+   */
+  size_t GetTempCount() const {
+    return m_temp_count;
+  }
+
+  /**
+   * @brief Get the max depth of the operand stack in running, which is known after verifying.
+   *
+   * @return size_t the depth
+   */
+  size_t GetMaxDepth() const {
+    return m_max_depth;
+  }
+
+  /**
+   * @brief Get the variables read by the expressions, in the order of first use.
+   *
+   * @return const std::vector<VarInfo>& the variables
+   */
+  const std::vector<VarInfo> &GetVars() const {
+    return m_vars;
+  }
+
+  /**
+   * @brief Get the comparisons of variables with constants, if the expression is a conjunction of them, so it can be
+   * evaluated over columns by `Operator::SelectBatch` and bitwise ANDs.
+   *
+   * @return std::vector<const Operator *> the comparisons, empty if the expression is not such a conjunction
+   */
+  std::vector<const Operator *> GetSelectConjuncts() const;
+
+  size_t Size() const {
+    return m_vector.size();
+  }
+
   auto begin() const  // NOLINT(readability-identifier-naming)
   {
     return m_vector.cbegin();
@@ -48,6 +123,9 @@ class OperatorVector {
  private:
   std::vector<const Operator *> m_vector;
   std::vector<const Operator *> m_to_release;
+  std::vector<VarInfo> m_vars;
+  size_t m_temp_count = 0;
+  size_t m_max_depth = 0;
 
   void Add(const Operator *op) {
     m_vector.push_back(op);
@@ -58,12 +136,21 @@ class OperatorVector {
     m_to_release.push_back(op);
   }
 
+  template <Byte T>
+  void AddVar(int32_t index) {
+    AddRelease(new IndexedVarOperator<T>(index));
+    AddVarInfo(m_vars, index, T);
+  }
+
   void Release() {
     for (const auto *op : m_to_release) {
       delete op;
     }
     m_to_release.clear();
     m_vector.clear();
+    m_vars.clear();
+    m_temp_count = 0;
+    m_max_depth = 0;
   }
 
   /**
@@ -87,6 +174,34 @@ class OperatorVector {
   [[nodiscard]] bool AddCastOperator(const Operator *const ops[][TYPE_NUM], Byte b);
 
   [[nodiscard]] bool AddFunOperator(Byte b);
+
+  /**
+   * @brief Verify the stack effects and the operand types of all the operators by simulating the types on the stack,
+   * so the stack never underflows in running, and the values are of the types required, except those of the
+   * variables, which depend on the input tuples.
+   *
+   * @throw StackUnderflow if an operator requires more operands than on the stack
+   * @throw OperandTypeMismatch if an operand is not of the required type
+   */
+  void Verify();
+
+  /**
+   * @brief Eliminate common subexpressions. Each subtree occurring more than once is evaluated only the first time,
+   * with the result stored in a temporary slot, and loaded from the slot for other occurrences.
+   */
+  void EliminateCommonSubexpressions();
+
+  /**
+   * @brief Add a relational operator of the specified type. If the operands are a variable and a constant, they are
+   * fused into a single operator.
+   *
+   * @param ops The array of the operators
+   * @param rel The byte of the relational operator
+   * @param type The type byte
+   * @return true Successful
+   * @return false Failed
+   */
+  [[nodiscard]] bool AddRelationOperator(const Operator *const ops[], Byte rel, Byte type);
 };
 
 }  // namespace dingodb::expr
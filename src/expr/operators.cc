@@ -17,6 +17,7 @@
 #include <cmath>
 
 #include "calc/arithmetic.h"
+#include "calc/datetime.h"
 #include "calc/mathematic.h"
 #include "calc/relational.h"
 #include "calc/special.h"
@@ -433,7 +434,7 @@ const Operator *const OP_NOT = new NotOperator();
 const Operator *const OP_AND = new AndOperator();
 const Operator *const OP_OR  = new OrOperator();
 
-const size_t FUN_NUM = 0x36;
+const size_t FUN_NUM = 0x45;
 
 const Operator *const OP_FUN[] = {
     [0x00] = nullptr,
@@ -490,6 +491,21 @@ const Operator *const OP_FUN[] = {
     [0x33] = nullptr,
     [0x34] = nullptr,
     [0x35] = nullptr,
+    [0x36] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::Year>,
+    [0x37] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::Quarter>,
+    [0x38] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::Month>,
+    [0x39] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::Day>,
+    [0x3A] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::DayOfWeek>,
+    [0x3B] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::Hour>,
+    [0x3C] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::Minute>,
+    [0x3D] = new UnaryOperator<TYPE_INT32, TYPE_TIMESTAMP, calc::Second>,
+    [0x3E] = new UnaryOperator<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncYear>,
+    [0x3F] = new UnaryOperator<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncQuarter>,
+    [0x40] = new UnaryOperator<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncMonth>,
+    [0x41] = new UnaryOperator<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncWeek>,
+    [0x42] = new UnaryOperator<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncDay>,
+    [0x43] = new UnaryOperator<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncHour>,
+    [0x44] = new UnaryOperator<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncMinute>,
 };
 
 }  // namespace dingodb::expr
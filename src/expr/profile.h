@@ -0,0 +1,56 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _EXPR_PROFILE_H_
+#define _EXPR_PROFILE_H_
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace dingodb::expr {
+
+/**
+ * @brief Counters of an operator, collected when profiling is enabled.
+ */
+struct OperatorProfile {
+  // Number of invocations.
+  uint64_t calls = 0;
+  // Cumulative cycles (nanoseconds on platforms without a time stamp counter).
+  uint64_t cycles = 0;
+  // Number of invocations resulting in `NULL`.
+  uint64_t nulls = 0;
+};
+
+/**
+ * @brief Read the time stamp counter.
+ *
+ * @return uint64_t the current cycles
+ */
+inline uint64_t ReadCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+}  // namespace dingodb::expr
+
+#endif /* _EXPR_PROFILE_H_ */
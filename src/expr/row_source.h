@@ -0,0 +1,85 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _EXPR_ROW_SOURCE_H_
+#define _EXPR_ROW_SOURCE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "operand.h"
+
+namespace dingodb::expr {
+
+/**
+ * @brief A source of the values of a row, which can be bound to a `Runner` instead of a `Tuple`.
+ */
+class RowSource {
+ public:
+  RowSource() = default;
+  virtual ~RowSource() = default;
+
+  /**
+   * @brief Get the value of a column.
+   *
+   * @param index the column index
+   * @return const Operand& the value
+   */
+  virtual const Operand &Get(int32_t index) const = 0;
+};
+
+/**
+ * @brief A row source decoding a column by the decoder only on first access. The decoded values are cached until the
+ * next `Reset`.
+ */
+class LazyRow : public RowSource {
+ public:
+  using Decoder = std::function<Operand(int32_t index)>;
+
+  LazyRow(size_t columns, Decoder decoder)
+      : m_values(columns), m_stamps(columns, 0), m_stamp(1), m_decoder(std::move(decoder)) {
+  }
+
+  ~LazyRow() override = default;
+
+  /**
+   * @brief Drop the decoded values, to decode the next row. The decoder is responsible for tracking the row.
+   */
+  void Reset() {
+    if (++m_stamp == 0) {
+      std::fill(m_stamps.begin(), m_stamps.end(), 0);
+      m_stamp = 1;
+    }
+  }
+
+  const Operand &Get(int32_t index) const override {
+    if (m_stamps[index] != m_stamp) {
+      m_values[index] = m_decoder(index);
+      m_stamps[index] = m_stamp;
+    }
+    return m_values[index];
+  }
+
+ private:
+  mutable Tuple m_values;
+  // A column is decoded if its stamp equals to the current one, so resetting does not need to touch every column.
+  mutable std::vector<uint32_t> m_stamps;
+  uint32_t m_stamp;
+  Decoder m_decoder;
+};
+
+}  // namespace dingodb::expr
+
+#endif /* _EXPR_ROW_SOURCE_H_ */
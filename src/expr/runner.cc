@@ -15,14 +15,63 @@
 #include "runner.h"
 
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 namespace dingodb::expr {
 
 void Runner::Run() const {
+  if (m_profiling) {
+    RunProfiled();
+    return;
+  }
+  m_operand_stack.Clear();
+  for (const auto *op : m_operator_vector) {
+    (*op)(m_operand_stack);
+  }
+}
+
+void Runner::RunProfiled() const {
   m_operand_stack.Clear();
+  auto *profile = m_profile.data();
   for (const auto *op : m_operator_vector) {
+    auto start = ReadCycles();
     (*op)(m_operand_stack);
+    profile->cycles += ReadCycles() - start;
+    ++profile->calls;
+    if (m_operand_stack.Top() == nullptr) {
+      ++profile->nulls;
+    }
+    ++profile;
+  }
+}
+
+std::string Runner::Disassemble() const {
+  std::ostringstream os;
+  size_t i = 0;
+  for (const auto *op : m_operator_vector) {
+    os << std::setw(4) << i++ << "  " << op->Describe() << "\n";
+  }
+  return os.str();
+}
+
+std::string Runner::DumpProfile() const {
+  std::ostringstream os;
+  os << std::setw(4) << "#" << std::setw(12) << "calls" << std::setw(16) << "cycles" << std::setw(12) << "nulls"
+     << "  operator\n";
+  size_t i = 0;
+  for (const auto *op : m_operator_vector) {
+    os << std::setw(4) << i;
+    if (i < m_profile.size()) {
+      const auto &p = m_profile[i];
+      os << std::setw(12) << p.calls << std::setw(16) << p.cycles << std::setw(12) << p.nulls;
+    } else {
+      os << std::setw(12) << "-" << std::setw(16) << "-" << std::setw(12) << "-";
+    }
+    os << "  " << op->Describe() << "\n";
+    ++i;
   }
+  return os.str();
 }
 
 Tuple *Runner::GetAll() const {
@@ -15,8 +15,12 @@
 #ifndef _EXPR_RUNNER_H_
 #define _EXPR_RUNNER_H_
 
+#include <string>
+#include <vector>
+
 #include "operand_stack.h"
 #include "operator_vector.h"
+#include "profile.h"
 #include "types.h"
 
 namespace dingodb::expr {
@@ -28,15 +32,66 @@ class Runner {
   virtual ~Runner() = default;
 
   const Byte *Decode(const Byte *code, size_t len) {
-    return m_operator_vector.Decode(code, len);
+    const auto *p = m_operator_vector.Decode(code, len);
+    m_operand_stack.ResizeTemps(m_operator_vector.GetTempCount());
+    m_operand_stack.Reserve(m_operator_vector.GetMaxDepth());
+    ResetProfile();
+    return p;
   }
 
   void BindTuple(const Tuple *tuple) const {
     m_operand_stack.BindTuple(tuple);
   }
 
+  /**
+   * @brief Bind a row source instead of a tuple, so columns are decoded on demand.
+   *
+   * @param row the row source
+   */
+  void BindRow(const RowSource *row) const {
+    m_operand_stack.BindRow(row);
+  }
+
   void Run() const;
 
+  /**
+   * @brief Enable or disable profiling. When enabled, `Run` records the counters of each operator, which are reset on
+   * each `Decode`. When disabled, `Run` costs nothing more than a branch.
+   *
+   * @param enabled true to enable
+   */
+  void EnableProfiling(bool enabled = true) {
+    m_profiling = enabled;
+    ResetProfile();
+  }
+
+  /**
+   * @brief Get the profiling counters, one for each entry of the operator vector.
+   *
+   * @return const std::vector<OperatorProfile>& the counters, empty if profiling is disabled
+   */
+  const std::vector<OperatorProfile> &GetProfile() const {
+    return m_profile;
+  }
+
+  void ResetProfile() {
+    m_profile.assign(m_profiling ? m_operator_vector.Size() : 0, OperatorProfile());
+  }
+
+  /**
+   * @brief Get a readable disassembly of the operator vector, one operator a line.
+   *
+   * @return std::string the disassembly
+   */
+  std::string Disassemble() const;
+
+  /**
+   * @brief Get the profiling counters against the disassembly, one operator a line.
+   *
+   * @return std::string the counters
+   */
+  std::string DumpProfile() const;
+
   Operand Get() const {
     return m_operand_stack.Get();
   }
@@ -56,10 +111,64 @@ class Runner {
 
   Tuple *GetAll() const;
 
+  /**
+   * @brief Get all the values into a caller-owned tuple, whose storage is reused. The values are moved out of the
+   * runner, so nothing can be got before the next run.
+   *
+   * @param tuple the tuple
+   */
+  void GetAll(Tuple &tuple) const {
+    m_operand_stack.MoveTo(tuple);
+  }
+
+  /**
+   * @brief Remove the expressions which are plain variables, for the caller to take them from the input directly.
+   * The other expressions are evaluated as before, in the same order.
+   *
+   * @return std::vector<int32_t> for each expression, the index of the variable, or -1 if it is still evaluated
+   */
+  std::vector<int32_t> RemovePassThroughs() {
+    return m_operator_vector.RemovePassThroughs();
+  }
+
+  /**
+   * @brief Get the variables read by the expressions, in the order of first use.
+   *
+   * @return const std::vector<VarInfo>& the variables
+   */
+  const std::vector<VarInfo> &GetVars() const {
+    return m_operator_vector.GetVars();
+  }
+
+  /**
+   * @brief Get the comparisons of variables with constants, if the expression is a conjunction of them (see
+   * `OperatorVector::GetSelectConjuncts`).
+   *
+   * @return std::vector<const Operator *> the comparisons, empty if the expression is not such a conjunction
+   */
+  std::vector<const Operator *> GetSelectConjuncts() const {
+    return m_operator_vector.GetSelectConjuncts();
+  }
+
+  auto begin() const  // NOLINT(readability-identifier-naming)
+  {
+    return m_operand_stack.begin();
+  }
+
+  auto end() const  // NOLINT(readability-identifier-naming)
+  {
+    return m_operand_stack.end();
+  }
+
  private:
   mutable OperandStack m_operand_stack;
 
   OperatorVector m_operator_vector;
+
+  bool m_profiling = false;
+  mutable std::vector<OperatorProfile> m_profile;
+
+  void RunProfiled() const;
 };
 
 }  // namespace dingodb::expr
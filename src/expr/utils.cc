@@ -61,19 +61,51 @@ std::string HexOfBytes(const Byte *data, size_t len) {
   return result;
 }
 
+std::string Int128ToString(__int128 value, int32_t scale) {
+  bool negative = value < 0;
+  unsigned __int128 v = negative ? -(unsigned __int128)value : (unsigned __int128)value;
+  std::string digits;
+  do {
+    digits.push_back((char)('0' + (int)(v % 10)));
+    v /= 10;
+  } while (v != 0);
+  if (scale > 0) {
+    if (digits.size() <= (size_t)scale) {
+      digits.append(scale + 1 - digits.size(), '0');
+    }
+    digits.insert(scale, 1, '.');
+  } else if (scale < 0) {
+    digits.insert(0, -scale, '0');
+  }
+  if (negative) {
+    digits.push_back('-');
+  }
+  return std::string(digits.rbegin(), digits.rend());
+}
+
 Tuple *ConcatTuple(const Tuple &t1, const Tuple &t2) {
-  auto *tuple = new Tuple(t1.size() + t2.size());
-  auto i = std::copy(t1.cbegin(), t1.cend(), tuple->begin());
-  std::copy(t2.cbegin(), t2.cend(), i);
+  auto *tuple = new Tuple();
+  ConcatTuple(*tuple, t1, t2);
   return tuple;
 }
 
+void ConcatTuple(Tuple &dst, const Tuple &t1, const Tuple &t2) {
+  dst.resize(t1.size() + t2.size());
+  auto i = std::copy(t1.cbegin(), t1.cend(), dst.begin());
+  std::copy(t2.cbegin(), t2.cend(), i);
+}
+
 Tuple *MapTuple(const Tuple &src, const int *index, size_t index_size) {
-  auto *tuple = new Tuple(index_size);
+  auto *tuple = new Tuple();
+  MapTuple(*tuple, src, index, index_size);
+  return tuple;
+}
+
+void MapTuple(Tuple &dst, const Tuple &src, const int *index, size_t index_size) {
+  dst.resize(index_size);
   for (int i = 0; i < index_size; ++i) {
-    (*tuple)[i] = src[index[i]];
+    dst[i] = src[index[i]];
   }
-  return tuple;
 }
 
 }  // namespace dingodb::expr
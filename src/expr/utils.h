@@ -29,10 +29,23 @@ void BytesToHex(char *hex, const Byte *buf, size_t len);
 
 std::string HexOfBytes(const Byte *data, size_t len);
 
+/**
+ * @brief Convert a scaled integer, i.e. `value * 10^-scale`, to the string of a decimal.
+ *
+ * @param value the unscaled value
+ * @param scale the scale, may be negative
+ * @return std::string the string
+ */
+std::string Int128ToString(__int128 value, int32_t scale);
+
 Tuple *ConcatTuple(const Tuple &t1, const Tuple &t2);
 
+void ConcatTuple(Tuple &dst, const Tuple &t1, const Tuple &t2);
+
 Tuple *MapTuple(const Tuple &src, const int *index, size_t index_size);
 
+void MapTuple(Tuple &dst, const Tuple &src, const int *index, size_t index_size);
+
 }  // namespace dingodb::expr
 
 #endif /* _EXPR_UTILS_H_ */
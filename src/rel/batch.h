@@ -0,0 +1,141 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _REL_BATCH_H_
+#define _REL_BATCH_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "../expr/operand.h"
+
+namespace dingodb::rel {
+
+using Selection = std::vector<uint32_t>;
+
+/**
+ * @brief A batch of tuples with a selection vector.
+ *
+ * The tuples put in a batch are borrowed, i.e. they are neither moved nor released by the operators. Filtering only
+ * removes indices from the selection vector, so several predicates can be chained without materializing intermediate
+ * tuples. Operators producing new tuples (like projecting) replace the tuples of the batch with ones owned by the
+ * batch, which are valid until the next use of the batch.
+ */
+class Batch {
+ public:
+  Batch() : m_current(0) {
+  }
+
+  Batch(const expr::Tuple *const tuples[], size_t count) : Batch() {
+    Reset(tuples, count);
+  }
+
+  /**
+   * @brief Reset the batch with new tuples, all of which are selected.
+   *
+   * @param tuples the tuples
+   * @param count number of the tuples
+   */
+  void Reset(const expr::Tuple *const tuples[], size_t count) {
+    m_tuples.assign(tuples, tuples + count);
+    SelectAll();
+  }
+
+  /**
+   * @brief Reset the batch with `count` tuples owned by the batch, all of which are selected.
+   *
+   * @param count number of the tuples
+   * @return std::vector<expr::Tuple>& the tuples to be filled by the caller
+   */
+  std::vector<expr::Tuple> &Reset(size_t count) {
+    m_selection.resize(count);
+    auto &tuples = PrepareOutputs();
+    ReplaceWithOutputs();
+    return tuples;
+  }
+
+  /**
+   * @brief Keep only the first `count` tuples, which are all selected.
+   *
+   * @param count number of the tuples to keep
+   */
+  void Truncate(size_t count) {
+    m_tuples.resize(count);
+    SelectAll();
+  }
+
+  size_t Size() const {
+    return m_tuples.size();
+  }
+
+  const expr::Tuple *GetTuple(uint32_t index) const {
+    return m_tuples[index];
+  }
+
+  Selection &GetSelection() {
+    return m_selection;
+  }
+
+  const Selection &GetSelection() const {
+    return m_selection;
+  }
+
+  bool Empty() const {
+    return m_selection.empty();
+  }
+
+  /**
+   * @brief Get the tuples for output, one for each selected tuple.
+   *
+   * Input tuples are still valid until `ReplaceWithOutputs` is called.
+   *
+   * @return std::vector<expr::Tuple>& the output tuples
+   */
+  std::vector<expr::Tuple> &PrepareOutputs() {
+    auto &outputs = m_outputs[m_current ^ 1];
+    outputs.resize(m_selection.size());
+    return outputs;
+  }
+
+  /**
+   * @brief Replace the tuples of the batch with the outputs, all of which are selected.
+   */
+  void ReplaceWithOutputs() {
+    m_current ^= 1;
+    auto &outputs = m_outputs[m_current];
+    m_tuples.resize(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      m_tuples[i] = &outputs[i];
+    }
+    SelectAll();
+  }
+
+ private:
+  std::vector<const expr::Tuple *> m_tuples;
+  Selection m_selection;
+
+  // Double buffered, for the inputs of an operator may be the outputs of the previous one.
+  std::vector<expr::Tuple> m_outputs[2];
+  int m_current;
+
+  void SelectAll() {
+    m_selection.resize(m_tuples.size());
+    for (uint32_t i = 0; i < m_selection.size(); ++i) {
+      m_selection[i] = i;
+    }
+  }
+};
+
+}  // namespace dingodb::rel
+
+#endif /* _REL_BATCH_H_ */
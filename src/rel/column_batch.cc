@@ -0,0 +1,741 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "column_batch.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "../expr/bitmap.h"
+#include "../expr/calc/batch.h"
+#include "../expr/exception.h"
+#include "../expr/operator.h"
+#include "../expr/utils.h"
+
+namespace dingodb::rel {
+
+using namespace dingodb::expr;
+
+namespace {
+
+const int64_t MILLISECONDS_PER_DAY = 86400000LL;
+
+struct ExportedSchema {
+  std::string format;
+  std::vector<struct ArrowSchema> children;
+  std::vector<struct ArrowSchema *> children_ptrs;
+};
+
+struct ExportedArray {
+  std::vector<Byte> validity;
+  std::vector<Byte> values;
+  std::vector<int32_t> offsets;
+  std::string data;
+  const void *buffers[3];
+  std::vector<struct ArrowArray> children;
+  std::vector<struct ArrowArray *> children_ptrs;
+};
+
+void ReleaseSchema(struct ArrowSchema *schema) {
+  auto *exported = static_cast<ExportedSchema *>(schema->private_data);
+  for (auto &child : exported->children) {
+    if (child.release != nullptr) {
+      child.release(&child);
+    }
+  }
+  delete exported;
+  schema->release = nullptr;
+}
+
+void ReleaseArray(struct ArrowArray *array) {
+  auto *exported = static_cast<ExportedArray *>(array->private_data);
+  for (auto &child : exported->children) {
+    if (child.release != nullptr) {
+      child.release(&child);
+    }
+  }
+  delete exported;
+  array->release = nullptr;
+}
+
+void InitSchema(struct ArrowSchema *schema, ExportedSchema *exported) {
+  schema->format = exported->format.c_str();
+  schema->name = "";
+  schema->metadata = nullptr;
+  schema->flags = ARROW_FLAG_NULLABLE;
+  schema->n_children = exported->children.size();
+  for (auto &child : exported->children) {
+    exported->children_ptrs.push_back(&child);
+  }
+  schema->children = exported->children_ptrs.empty() ? nullptr : exported->children_ptrs.data();
+  schema->dictionary = nullptr;
+  schema->release = ReleaseSchema;
+  schema->private_data = exported;
+}
+
+const char *FormatOf(Byte type) {
+  switch (type) {
+  case TYPE_BOOL:
+    return "b";
+  case TYPE_INT32:
+    return "i";
+  case TYPE_INT64:
+    return "l";
+  case TYPE_FLOAT:
+    return "f";
+  case TYPE_DOUBLE:
+    return "g";
+  case TYPE_DECIMAL:
+  case TYPE_STRING:
+    return "u";
+  case TYPE_DATE:
+    return "tdm";
+  case TYPE_TIMESTAMP:
+    return "tsm:";
+  default:
+    break;
+  }
+  return "n";
+}
+
+size_t WidthOf(Byte type) {
+  switch (type) {
+  case TYPE_INT32:
+  case TYPE_FLOAT:
+    return 4;
+  case TYPE_INT64:
+  case TYPE_DOUBLE:
+  case TYPE_DATE:
+  case TYPE_TIMESTAMP:
+    return 8;
+  default:
+    break;
+  }
+  return 0;
+}
+
+void ReleaseImportedArray(struct ArrowArray *array) {
+  if (array->release != nullptr) {
+    array->release(array);
+  }
+  delete array;
+}
+
+// Whether the valid codes of a dictionary-encoded column are indices into the dictionary.
+template <typename T>
+bool CodesInRange(const T *codes, const Byte *validity, int64_t offset, int64_t length, int64_t size) {
+  for (int64_t i = offset; i < offset + length; ++i) {
+    if (!expr::IsValid(validity, i)) {
+      continue;
+    }
+    if constexpr (std::is_signed_v<T>) {
+      if (codes[i] < 0) {
+        return false;
+      }
+    }
+    if (static_cast<uint64_t>(codes[i]) >= static_cast<uint64_t>(size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void AppendBytes(std::vector<Byte> &values, T value) {
+  size_t size = values.size();
+  values.resize(size + sizeof(T));
+  memcpy(values.data() + size, &value, sizeof(T));
+}
+
+}  // namespace
+
+ColumnBatch::ColumnBatch(struct ArrowSchema *schema, struct ArrowArray *array)
+    : m_schema(*schema), m_array(new struct ArrowArray(*array), ReleaseImportedArray) {
+  schema->release = nullptr;
+  array->release = nullptr;
+  try {
+    if (strcmp(m_schema.format, "+s") != 0 || m_schema.n_children != m_array->n_children) {
+      throw ExprError("Arrow array of type struct required for column batch.");
+    }
+    m_columns.resize(m_array->n_children);
+    for (int64_t i = 0; i < m_array->n_children; ++i) {
+      InitColumn(m_columns[i], m_schema.children[i], m_array->children[i], m_array->offset, m_array->length);
+    }
+  } catch (...) {
+    // The array is released along with `m_array`.
+    m_schema.release(&m_schema);
+    throw;
+  }
+}
+
+void ColumnBatch::InitColumn(
+    Column &column,
+    const struct ArrowSchema *s,
+    const struct ArrowArray *a,
+    int64_t offset,
+    int64_t length
+) {
+  column.layout = Column::PLAIN;
+  column.factor = 1;
+  column.scale = 0;
+  column.array = a;
+  column.offset = offset + a->offset;
+  column.length = length;
+  column.validity = (a->null_count != 0 && a->n_buffers > 0) ? static_cast<const Byte *>(a->buffers[0]) : nullptr;
+  column.values = a->n_buffers > 1 ? a->buffers[1] : nullptr;
+  column.data = a->n_buffers > 2 ? static_cast<const char *>(a->buffers[2]) : nullptr;
+  column.dictionary = nullptr;
+  if (s->dictionary != nullptr) {
+    InitDictionary(column, s, a);
+    return;
+  }
+  const char *format = s->format;
+  if (strcmp(format, "n") == 0) {
+    column.type = TYPE_NULL;
+  } else if (strcmp(format, "b") == 0) {
+    column.type = TYPE_BOOL;
+  } else if (strcmp(format, "i") == 0) {
+    column.type = TYPE_INT32;
+  } else if (strcmp(format, "l") == 0) {
+    column.type = TYPE_INT64;
+  } else if (strcmp(format, "f") == 0) {
+    column.type = TYPE_FLOAT;
+  } else if (strcmp(format, "g") == 0) {
+    column.type = TYPE_DOUBLE;
+  } else if (strcmp(format, "u") == 0) {
+    column.type = TYPE_STRING;
+  } else if (strcmp(format, "U") == 0) {
+    column.type = TYPE_STRING;
+    column.layout = Column::LARGE_UTF8;
+  } else if (strcmp(format, "tdD") == 0) {
+    column.type = TYPE_DATE;
+    column.layout = Column::DATE32;
+  } else if (strcmp(format, "tdm") == 0) {
+    column.type = TYPE_DATE;
+  } else if (strncmp(format, "ts", 2) == 0 && format[2] != '\0' && format[3] == ':') {
+    column.type = TYPE_TIMESTAMP;
+    switch (format[2]) {
+    case 's':
+      column.factor = 1000;
+      break;
+    case 'm':
+      column.factor = 1;
+      break;
+    case 'u':
+      column.factor = -1000;
+      break;
+    case 'n':
+      column.factor = -1000000;
+      break;
+    default:
+      throw ExprError("Unsupported arrow format \"" + std::string(format) + "\".");
+    }
+  } else if (strncmp(format, "d:", 2) == 0) {
+    int precision;
+    int scale;
+    int bits = 128;
+    if (sscanf(format + 2, "%d,%d,%d", &precision, &scale, &bits) < 2 || bits != 128) {
+      throw ExprError("Unsupported arrow format \"" + std::string(format) + "\".");
+    }
+    column.type = TYPE_DECIMAL;
+    column.layout = Column::DECIMAL128;
+    column.scale = scale;
+  } else {
+    throw ExprError("Unsupported arrow format \"" + std::string(format) + "\".");
+  }
+}
+
+void ColumnBatch::InitDictionary(Column &column, const struct ArrowSchema *s, const struct ArrowArray *a) {
+  if (a->dictionary == nullptr) {
+    throw ExprError("Dictionary of arrow array not provided.");
+  }
+  const char *format = s->format;
+  if (format[0] == '\0' || format[1] != '\0') {
+    throw ExprError("Unsupported arrow format \"" + std::string(format) + "\" of dictionary indices.");
+  }
+  switch (format[0]) {
+  case 'c':
+  case 'C':
+    column.code_width = 1;
+    break;
+  case 's':
+  case 'S':
+    column.code_width = 2;
+    break;
+  case 'i':
+  case 'I':
+    column.code_width = 4;
+    break;
+  case 'l':
+  case 'L':
+    column.code_width = 8;
+    break;
+  default:
+    throw ExprError("Unsupported arrow format \"" + std::string(format) + "\" of dictionary indices.");
+  }
+  column.code_signed = islower(format[0]);
+  column.dictionary = std::make_shared<Column>();
+  InitColumn(*column.dictionary, s->dictionary, a->dictionary, 0, a->dictionary->length);
+  if (column.dictionary->type != TYPE_STRING || column.dictionary->dictionary != nullptr) {
+    throw ExprError("Only dictionaries of strings are supported.");
+  }
+  column.type = TYPE_STRING;
+  column.layout = Column::DICTIONARY;
+  // The codes are used as indices into the dictionary, so they are checked once per batch.
+  bool in_range;
+  auto size = a->dictionary->length;
+  if (column.length == 0) {
+    in_range = true;
+  } else if (column.values == nullptr) {
+    in_range = false;
+  } else {
+    switch (format[0]) {
+    case 'c':
+      in_range = CodesInRange(static_cast<const int8_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    case 'C':
+      in_range = CodesInRange(static_cast<const uint8_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    case 's':
+      in_range = CodesInRange(static_cast<const int16_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    case 'S':
+      in_range = CodesInRange(static_cast<const uint16_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    case 'i':
+      in_range = CodesInRange(static_cast<const int32_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    case 'I':
+      in_range = CodesInRange(static_cast<const uint32_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    case 'l':
+      in_range = CodesInRange(static_cast<const int64_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    default:
+      in_range = CodesInRange(static_cast<const uint64_t *>(column.values), column.validity, column.offset,
+                              column.length, size);
+      break;
+    }
+  }
+  if (!in_range) {
+    throw ExprError("Dictionary indices out of range of the dictionary of " + std::to_string(size) + " entries.");
+  }
+}
+
+ColumnBatch::~ColumnBatch() {
+  if (m_schema.release != nullptr) {
+    m_schema.release(&m_schema);
+  }
+}
+
+bool ColumnBatch::IsValid(const Column &column, int64_t row) const {
+  if (column.type == TYPE_NULL) {
+    return false;
+  }
+  if (m_array->null_count != 0 && m_array->n_buffers > 0 && m_array->buffers[0] != nullptr &&
+      !BitmapGet(static_cast<const Byte *>(m_array->buffers[0]), m_array->offset + row)) {
+    return false;
+  }
+  return expr::IsValid(column.validity, column.offset + row);
+}
+
+String ColumnBatch::GetString(const Column &column, int64_t index) const {
+  int64_t start;
+  int64_t end;
+  if (column.layout == Column::LARGE_UTF8) {
+    const auto *offsets = static_cast<const int64_t *>(column.values);
+    start = offsets[index];
+    end = offsets[index + 1];
+  } else {
+    const auto *offsets = static_cast<const int32_t *>(column.values);
+    start = offsets[index];
+    end = offsets[index + 1];
+  }
+  // A slice of the data buffer, which keeps the array alive.
+  return String(m_array, column.data + start, end - start);
+}
+
+const std::vector<Operand> &ColumnBatch::GetDictionary(size_t col) const {
+  const Column &column = m_columns[col];
+  const Column &dictionary = *column.dictionary;
+  if (column.entries.empty() && dictionary.length > 0) {
+    column.entries.reserve(dictionary.length);
+    for (int64_t i = 0; i < dictionary.length; ++i) {
+      int64_t index = dictionary.offset + i;
+      if (expr::IsValid(dictionary.validity, index)) {
+        column.entries.emplace_back(GetString(dictionary, index));
+      } else {
+        column.entries.emplace_back(nullptr);
+      }
+    }
+  }
+  return column.entries;
+}
+
+int64_t ColumnBatch::GetCode(size_t col, size_t row) const {
+  const Column &column = m_columns[col];
+  if (!IsValid(column, row)) {
+    return -1;
+  }
+  int64_t index = column.offset + row;
+  switch (column.code_width) {
+  case 1:
+    return column.code_signed ? static_cast<const int8_t *>(column.values)[index]
+                              : static_cast<const uint8_t *>(column.values)[index];
+  case 2:
+    return column.code_signed ? static_cast<const int16_t *>(column.values)[index]
+                              : static_cast<const uint16_t *>(column.values)[index];
+  case 4:
+    return column.code_signed ? static_cast<const int32_t *>(column.values)[index]
+                              : static_cast<const uint32_t *>(column.values)[index];
+  default:
+    // Checked to be in range of the dictionary, so unsigned codes fit.
+    return column.code_signed ? static_cast<const int64_t *>(column.values)[index]
+                              : static_cast<int64_t>(static_cast<const uint64_t *>(column.values)[index]);
+  }
+}
+
+Operand ColumnBatch::GetOperand(size_t col, size_t row) const {
+  const Column &column = m_columns[col];
+  if (column.layout == Column::DICTIONARY) {
+    int64_t code = GetCode(col, row);
+    return code < 0 ? nullptr : GetDictionary(col)[code];
+  }
+  if (!IsValid(column, row)) {
+    return nullptr;
+  }
+  int64_t index = column.offset + row;
+  switch (column.type) {
+  case TYPE_BOOL:
+    return BitmapGet(static_cast<const Byte *>(column.values), index);
+  case TYPE_INT32:
+    return static_cast<const int32_t *>(column.values)[index];
+  case TYPE_INT64:
+    return static_cast<const int64_t *>(column.values)[index];
+  case TYPE_FLOAT:
+    return static_cast<const float *>(column.values)[index];
+  case TYPE_DOUBLE:
+    return static_cast<const double *>(column.values)[index];
+  case TYPE_STRING:
+    return GetString(column, index);
+  case TYPE_DATE:
+    if (column.layout == Column::DATE32) {
+      return static_cast<const int32_t *>(column.values)[index] * MILLISECONDS_PER_DAY;
+    }
+    return static_cast<const int64_t *>(column.values)[index];
+  case TYPE_TIMESTAMP: {
+    int64_t v = static_cast<const int64_t *>(column.values)[index];
+    return column.factor > 0 ? v * column.factor : v / -column.factor;
+  }
+  case TYPE_DECIMAL: {
+    __int128 v;
+    memcpy(&v, static_cast<const Byte *>(column.values) + index * sizeof(v), sizeof(v));
+    return DecimalP(Int128ToString(v, column.scale));
+  }
+  default:
+    break;
+  }
+  return nullptr;
+}
+
+void ColumnBatch::HashColumn(size_t col, uint64_t *hashes) const {
+  const Column &column = m_columns[col];
+  size_t count = Size();
+  if (column.layout == Column::DICTIONARY) {
+    const auto &entries = GetDictionary(col);
+    std::vector<uint64_t> entry_hashes(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      entry_hashes[i] = HashValue(entries[i]);
+    }
+    for (size_t j = 0; j < count; ++j) {
+      auto code = GetCode(col, j);
+      hashes[j] = HashCombine(hashes[j], code < 0 ? HASH_NULL : entry_hashes[code]);
+    }
+    return;
+  }
+  // The kernels read bitmaps from bit 0, and values as they are.
+  bool in_place = column.layout == Column::PLAIN && column.factor == 1 && column.offset % 8 == 0 &&
+                  (m_array->null_count == 0 || m_array->n_buffers == 0 || m_array->buffers[0] == nullptr);
+  if (in_place) {
+    const Byte *validity = column.validity != nullptr ? column.validity + column.offset / 8 : nullptr;
+    switch (column.type) {
+    case TYPE_INT32:
+      calc::HashBatch(hashes, static_cast<const int32_t *>(column.values) + column.offset, validity, count);
+      return;
+    case TYPE_INT64:
+    case TYPE_DATE:
+    case TYPE_TIMESTAMP:
+      calc::HashBatch(hashes, static_cast<const int64_t *>(column.values) + column.offset, validity, count);
+      return;
+    case TYPE_FLOAT:
+      calc::HashBatch(hashes, static_cast<const float *>(column.values) + column.offset, validity, count);
+      return;
+    case TYPE_DOUBLE:
+      calc::HashBatch(hashes, static_cast<const double *>(column.values) + column.offset, validity, count);
+      return;
+    default:
+      break;
+    }
+  }
+  for (size_t j = 0; j < count; ++j) {
+    hashes[j] = HashCombine(hashes[j], HashValue(GetOperand(col, j)));
+  }
+}
+
+bool ColumnBatch::SelectColumn(const expr::Operator *op, Byte *bits) const {
+  Byte type;
+  auto col = op->GetSelectVar(type);
+  if (col < 0 || (size_t)col >= m_columns.size()) {
+    return false;
+  }
+  const Column &column = m_columns[col];
+  // The same as `HashColumn`, and the kernels read values of the type of the variable.
+  bool in_place = column.layout == Column::PLAIN && column.factor == 1 && column.offset % 8 == 0 &&
+                  column.type == type && WidthOf(type) != 0 && column.values != nullptr &&
+                  (m_array->null_count == 0 || m_array->n_buffers == 0 || m_array->buffers[0] == nullptr);
+  if (!in_place) {
+    return false;
+  }
+  size_t count = Size();
+  op->SelectBatch(bits, static_cast<const char *>(column.values) + column.offset * WidthOf(type), count);
+  if (column.validity != nullptr) {
+    AndValidity(bits, bits, column.validity + column.offset / 8, count);
+  }
+  return true;
+}
+
+void ColumnBatch::ToTuples(std::vector<Tuple> &tuples) const {
+  size_t count = Size();
+  for (size_t j = 0; j < count; ++j) {
+    tuples[j].resize(m_columns.size());
+  }
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    for (size_t j = 0; j < count; ++j) {
+      tuples[j][i] = GetOperand(i, j);
+    }
+  }
+}
+
+void ColumnBatch::ToTuples(std::vector<Tuple> &tuples, const std::vector<int32_t> &columns) const {
+  size_t count = Size();
+  for (size_t j = 0; j < count; ++j) {
+    tuples[j].assign(m_columns.size(), nullptr);
+  }
+  for (auto i : columns) {
+    if (i < 0 || (size_t)i >= m_columns.size()) {
+      throw ExprError("Column index " + std::to_string(i) + " out of range of the column batch.");
+    }
+    for (size_t j = 0; j < count; ++j) {
+      tuples[j][i] = GetOperand(i, j);
+    }
+  }
+}
+
+void ColumnBatch::ToTuples(
+    std::vector<Tuple> &tuples,
+    const std::vector<int32_t> &columns,
+    const Selection &rows
+) const {
+  for (auto j : rows) {
+    tuples[j].assign(m_columns.size(), nullptr);
+  }
+  for (auto i : columns) {
+    if (i < 0 || (size_t)i >= m_columns.size()) {
+      throw ExprError("Column index " + std::to_string(i) + " out of range of the column batch.");
+    }
+    for (auto j : rows) {
+      tuples[j][i] = GetOperand(i, j);
+    }
+  }
+}
+
+ColumnBatchBuilder::ColumnBatchBuilder(const std::vector<Byte> &types) : m_types(types) {
+  Reset();
+}
+
+void ColumnBatchBuilder::Reset() {
+  m_columns.clear();
+  m_columns.resize(m_types.size());
+  for (size_t i = 0; i < m_types.size(); ++i) {
+    m_columns[i].type = m_types[i];
+  }
+  m_length = 0;
+}
+
+void ColumnBatchBuilder::Pad(Column &column, size_t rows) {
+  // The leading offset, also required if the first row is not null.
+  if ((column.type == TYPE_STRING || column.type == TYPE_DECIMAL) && column.offsets.empty()) {
+    column.offsets.push_back(0);
+  }
+  if (column.slots >= rows) {
+    return;
+  }
+  switch (column.type) {
+  case TYPE_NULL:
+    return;
+  case TYPE_BOOL:
+    column.values.resize(BitmapBytes(rows), 0);
+    break;
+  case TYPE_STRING:
+  case TYPE_DECIMAL:
+    column.offsets.resize(rows + 1, (int32_t)column.data.size());
+    break;
+  default:
+    column.values.resize(rows * WidthOf(column.type), 0);
+    break;
+  }
+  column.slots = rows;
+}
+
+void ColumnBatchBuilder::AppendValue(Column &column, size_t row, const Operand &v) {
+  if (column.validity.size() < BitmapBytes(row + 1)) {
+    column.validity.push_back(0);
+  }
+  if (v == nullptr) {
+    ++column.null_count;
+    return;
+  }
+  BitmapSet(column.validity.data(), row);
+  if (column.type == TYPE_NULL) {
+    column.type = v.GetType();
+  }
+  Pad(column, row);
+  switch (column.type) {
+  case TYPE_BOOL:
+    column.values.resize(BitmapBytes(row + 1), 0);
+    if (v.GetValue<bool>()) {
+      BitmapSet(column.values.data(), row);
+    }
+    break;
+  case TYPE_INT32:
+    AppendBytes(column.values, v.GetValue<int32_t>());
+    break;
+  case TYPE_INT64:
+  case TYPE_DATE:
+  case TYPE_TIMESTAMP:
+    AppendBytes(column.values, v.GetValue<int64_t>());
+    break;
+  case TYPE_FLOAT:
+    AppendBytes(column.values, v.GetValue<float>());
+    break;
+  case TYPE_DOUBLE:
+    AppendBytes(column.values, v.GetValue<double>());
+    break;
+  case TYPE_STRING: {
+    auto view = v.GetValue<String>().View();
+    column.data.append(view.data(), view.size());
+    column.offsets.push_back((int32_t)column.data.size());
+    break;
+  }
+  case TYPE_DECIMAL:
+    column.data.append(v.GetValue<DecimalP>().ToString());
+    column.offsets.push_back((int32_t)column.data.size());
+    break;
+  default:
+    throw ExprError(std::string("Unsupported type ") + TypeName(column.type) + " for column batch.");
+  }
+  column.slots = row + 1;
+}
+
+void ColumnBatchBuilder::Append(const Tuple &tuple) {
+  if (m_length == 0 && m_columns.empty()) {
+    m_columns.resize(tuple.size());
+  }
+  if (tuple.size() != m_columns.size()) {
+    throw ExprError("Tuple of size " + std::to_string(tuple.size()) + " cannot be appended to a column batch of " +
+                    std::to_string(m_columns.size()) + " columns.");
+  }
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    AppendValue(m_columns[i], m_length, tuple[i]);
+  }
+  ++m_length;
+}
+
+void ColumnBatchBuilder::Append(const Batch &batch) {
+  for (auto i : batch.GetSelection()) {
+    Append(*batch.GetTuple(i));
+  }
+}
+
+void ColumnBatchBuilder::Finish(struct ArrowSchema *schema, struct ArrowArray *array) {
+  auto *exported_schema = new ExportedSchema;
+  exported_schema->format = "+s";
+  exported_schema->children.resize(m_columns.size());
+  auto *exported_array = new ExportedArray;
+  exported_array->children.resize(m_columns.size());
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    Column &column = m_columns[i];
+    Pad(column, m_length);
+    auto *child_schema = new ExportedSchema;
+    child_schema->format = FormatOf(column.type);
+    InitSchema(&exported_schema->children[i], child_schema);
+    auto *child = new ExportedArray;
+    struct ArrowArray &a = exported_array->children[i];
+    a.length = m_length;
+    a.offset = 0;
+    a.n_children = 0;
+    a.children = nullptr;
+    a.dictionary = nullptr;
+    a.release = ReleaseArray;
+    a.private_data = child;
+    a.buffers = child->buffers;
+    if (column.type == TYPE_NULL) {
+      a.null_count = m_length;
+      a.n_buffers = 0;
+      continue;
+    }
+    child->validity = std::move(column.validity);
+    child->buffers[0] = column.null_count == 0 ? nullptr : child->validity.data();
+    a.null_count = column.null_count;
+    if (column.type == TYPE_STRING || column.type == TYPE_DECIMAL) {
+      child->offsets = std::move(column.offsets);
+      child->data = std::move(column.data);
+      child->buffers[1] = child->offsets.data();
+      child->buffers[2] = child->data.data();
+      a.n_buffers = 3;
+    } else {
+      child->values = std::move(column.values);
+      child->buffers[1] = child->values.data();
+      a.n_buffers = 2;
+    }
+  }
+  InitSchema(schema, exported_schema);
+  array->length = m_length;
+  array->null_count = 0;
+  array->offset = 0;
+  array->n_buffers = 1;
+  exported_array->buffers[0] = nullptr;
+  array->buffers = exported_array->buffers;
+  array->n_children = exported_array->children.size();
+  for (auto &child : exported_array->children) {
+    exported_array->children_ptrs.push_back(&child);
+  }
+  array->children = exported_array->children_ptrs.empty() ? nullptr : exported_array->children_ptrs.data();
+  array->dictionary = nullptr;
+  array->release = ReleaseArray;
+  array->private_data = exported_array;
+  Reset();
+}
+
+}  // namespace dingodb::rel
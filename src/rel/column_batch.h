@@ -0,0 +1,258 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _REL_COLUMN_BATCH_H_
+#define _REL_COLUMN_BATCH_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../expr/operand.h"
+#include "../expr/types.h"
+#include "arrow_abi.h"
+#include "batch.h"
+
+namespace dingodb::expr {
+class Operator;
+}
+
+namespace dingodb::rel {
+
+/**
+ * @brief A batch of columns in the layout of the Arrow C data interface, i.e. an array of type struct (format "+s")
+ * whose children are the columns.
+ *
+ * The buffers are read in place, values are converted to operands only when requested. Supported formats are
+ *  - "n" (null), "b" (bool), "i" (int32), "l" (int64), "f" (float), "g" (double)
+ *  - "u" (utf8), "U" (large utf8)
+ *  - "tdD" (date32), "tdm" (date64), "ts?:..." (timestamps of any unit, timezone ignored)
+ *  - "d:p,s" (decimal128)
+ *  - dictionary-encoded strings, i.e. indices of any integer format with a dictionary of utf8 or large utf8, which
+ *    must be in range of the dictionary, or `ExprError` is thrown on construction
+ *
+ * Dates and timestamps are converted to milliseconds. Strings are slices of the data buffers, which keep the array
+ * alive after the batch is destroyed, so a value kept longer should be detached (see `expr::String::Detached`). The
+ * entries of a dictionary are decoded once, and shared by the values of the column.
+ */
+class ColumnBatch {
+ public:
+  /**
+   * @brief Construct a new Column Batch object. The schema and array are moved into the batch, that is, their
+   * `release` callbacks are set to `nullptr` and the batch will release them on destruction.
+   *
+   * @param schema the schema
+   * @param array the array
+   */
+  ColumnBatch(struct ArrowSchema *schema, struct ArrowArray *array);
+
+  virtual ~ColumnBatch();
+
+  ColumnBatch(const ColumnBatch &) = delete;
+  ColumnBatch &operator=(const ColumnBatch &) = delete;
+
+  size_t Size() const {
+    return m_array->length;
+  }
+
+  size_t GetColumnCount() const {
+    return m_columns.size();
+  }
+
+  expr::Byte GetType(size_t col) const {
+    return m_columns[col].type;
+  }
+
+  /**
+   * @brief Get the value at the specified position.
+   *
+   * @param col the column index
+   * @param row the row index
+   * @return expr::Operand the value
+   */
+  expr::Operand GetOperand(size_t col, size_t row) const;
+
+  /**
+   * @brief Whether a column is dictionary-encoded.
+   *
+   * @param col the column index
+   */
+  bool IsDictionary(size_t col) const {
+    return m_columns[col].layout == Column::DICTIONARY;
+  }
+
+  /**
+   * @brief Get the decoded entries of the dictionary of a column, which is decoded on the first call.
+   *
+   * @param col the column index, which must be dictionary-encoded
+   * @return const std::vector<expr::Operand>& the entries, a null entry is `NULL`
+   */
+  const std::vector<expr::Operand> &GetDictionary(size_t col) const;
+
+  /**
+   * @brief Get the code of a value of a dictionary-encoded column, i.e. the index into the dictionary.
+   *
+   * @param col the column index, which must be dictionary-encoded
+   * @param row the row index
+   * @return int64_t the code, or -1 if the value is null
+   */
+  int64_t GetCode(size_t col, size_t row) const;
+
+  /**
+   * @brief Combine the hashes of the values of a column into those of the rows (see `calc::HashBatch`). Fixed-width
+   * values are hashed in place, and the entries of a dictionary once per batch.
+   *
+   * @param col the column index
+   * @param hashes the hashes of the rows, must be of the same size as the batch
+   */
+  void HashColumn(size_t col, uint64_t *hashes) const;
+
+  /**
+   * @brief Evaluate a comparison of a variable with a constant over the column of the variable in place (see
+   * `expr::Operator::SelectBatch`), which is possible only if the values are stored as they are, i.e. of a fixed-width
+   * type other than date32 or timestamps not in milliseconds, and the type is that of the variable.
+   *
+   * @param op the comparison
+   * @param bits the output bitmap, `BitmapBytes(Size())` bytes, bit set where the comparison is true and the value is
+   * not null
+   * @return true if the comparison is evaluated, false if it is to be evaluated on tuples
+   */
+  bool SelectColumn(const expr::Operator *op, expr::Byte *bits) const;
+
+  /**
+   * @brief Convert the batch to tuples.
+   *
+   * @param tuples the tuples, must be of the same size as the batch
+   */
+  void ToTuples(std::vector<expr::Tuple> &tuples) const;
+
+  /**
+   * @brief Convert the batch to tuples, decoding only the specified columns. Other columns are set to `NULL`.
+   *
+   * @param tuples the tuples, must be of the same size as the batch
+   * @param columns indices of the columns to decode
+   */
+  void ToTuples(std::vector<expr::Tuple> &tuples, const std::vector<int32_t> &columns) const;
+
+  /**
+   * @brief Convert the specified rows of the batch to tuples, decoding only the specified columns. Other tuples are
+   * left untouched.
+   *
+   * @param tuples the tuples, must be of the same size as the batch
+   * @param columns indices of the columns to decode
+   * @param rows indices of the rows to decode
+   */
+  void ToTuples(std::vector<expr::Tuple> &tuples, const std::vector<int32_t> &columns, const Selection &rows) const;
+
+ private:
+  struct Column {
+    expr::Byte type;
+    // Special cases of the types.
+    enum { PLAIN, DATE32, LARGE_UTF8, DECIMAL128, DICTIONARY } layout;
+    // For timestamps, the factor to milliseconds, negative for dividing.
+    int64_t factor;
+    // For decimals.
+    int32_t scale;
+    const struct ArrowArray *array;
+    int64_t offset;
+    const expr::Byte *validity;
+    const void *values;
+    const char *data;
+    int64_t length;
+    // For dictionaries, the width in bytes and signedness of the codes, and the column of the entries.
+    int32_t code_width;
+    bool code_signed;
+    std::shared_ptr<Column> dictionary;
+    mutable std::vector<expr::Operand> entries;
+  };
+
+  struct ArrowSchema m_schema;
+  // Shared with the string values, and released by the last of them.
+  std::shared_ptr<struct ArrowArray> m_array;
+  std::vector<Column> m_columns;
+
+  static void InitColumn(
+      Column &column,
+      const struct ArrowSchema *schema,
+      const struct ArrowArray *array,
+      int64_t offset,
+      int64_t length
+  );
+
+  static void InitDictionary(Column &column, const struct ArrowSchema *schema, const struct ArrowArray *array);
+
+  bool IsValid(const Column &column, int64_t row) const;
+
+  expr::String GetString(const Column &column, int64_t index) const;
+};
+
+/**
+ * @brief Build a batch of columns in the layout of the Arrow C data interface from tuples.
+ *
+ * The type of each column is given or deduced from the first non-null value. Decimals are exported as utf8 strings.
+ */
+class ColumnBatchBuilder {
+ public:
+  /**
+   * @brief Construct a new Column Batch Builder object.
+   *
+   * @param types types of the columns, the number of columns and the types are deduced from the tuples if empty
+   */
+  ColumnBatchBuilder(const std::vector<expr::Byte> &types = {});
+
+  virtual ~ColumnBatchBuilder() = default;
+
+  void Append(const expr::Tuple &tuple);
+
+  /**
+   * @brief Append the selected tuples of a batch.
+   *
+   * @param batch the batch
+   */
+  void Append(const Batch &batch);
+
+  /**
+   * @brief Export the built columns and reset the builder. The caller takes the ownership of the exported structures.
+   *
+   * @param schema the schema to export to
+   * @param array the array to export to
+   */
+  void Finish(struct ArrowSchema *schema, struct ArrowArray *array);
+
+ private:
+  struct Column {
+    expr::Byte type;
+    // Number of value slots filled, nulls are padded lazily.
+    size_t slots;
+    size_t null_count;
+    std::vector<expr::Byte> validity;
+    std::vector<expr::Byte> values;
+    std::vector<int32_t> offsets;
+    std::string data;
+  };
+
+  std::vector<expr::Byte> m_types;
+  std::vector<Column> m_columns;
+  size_t m_length;
+
+  void Reset();
+
+  static void AppendValue(Column &column, size_t row, const expr::Operand &v);
+
+  static void Pad(Column &column, size_t rows);
+};
+
+}  // namespace dingodb::rel
+
+#endif /* _REL_COLUMN_BATCH_H_ */
@@ -0,0 +1,75 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _REL_DICTIONARY_H_
+#define _REL_DICTIONARY_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../expr/operand.h"
+
+namespace dingodb::rel {
+
+/**
+ * @brief A dictionary of strings, which assigns dense codes from 0 to the strings in the order of first encoding.
+ *
+ * Unlike the dictionary of a column batch, the codes are stable across batches, so they can be used as grouping keys.
+ */
+class Dictionary {
+ public:
+  Dictionary() = default;
+  virtual ~Dictionary() = default;
+
+  Dictionary(const Dictionary &) = delete;
+  Dictionary &operator=(const Dictionary &) = delete;
+
+  /**
+   * @brief Get the code of a string, which is added if not in the dictionary.
+   *
+   * @param value the string
+   * @return int64_t the code
+   */
+  int64_t Encode(const expr::String &value) {
+    auto it = m_codes.find(value);
+    if (it == m_codes.end()) {
+      auto entry = value.Detached();
+      it = m_codes.emplace(entry, (int64_t)m_entries.size()).first;
+      m_entries.emplace_back(std::move(entry));
+    }
+    return it->second;
+  }
+
+  /**
+   * @brief Get the string of a code.
+   *
+   * @param code the code, must be got from `Encode`
+   * @return const expr::Operand& the string
+   */
+  const expr::Operand &Decode(int64_t code) const {
+    return m_entries[code];
+  }
+
+  size_t Size() const {
+    return m_entries.size();
+  }
+
+ private:
+  std::unordered_map<expr::String, int64_t> m_codes;
+  std::vector<expr::Operand> m_entries;
+};
+
+}  // namespace dingodb::rel
+
+#endif /* _REL_DICTIONARY_H_ */
@@ -14,6 +14,10 @@
 
 #include "agg.h"
 
+#include <string>
+
+#include "../../expr/utils.h"
+
 namespace dingodb::rel::op {
 
 expr::Operand CountAllAgg::Add(const expr::Operand &var, [[maybe_unused]] const expr::Tuple *tuple) const {
@@ -23,4 +27,116 @@ expr::Operand CountAllAgg::Add(const expr::Operand &var, [[maybe_unused]] const
   return 1LL;
 }
 
+const Agg *CountAllAgg::MergeAgg(int32_t index) const {
+  return new SumAgg<int64_t>(index);
+}
+
+namespace {
+
+// Max number of decimal digits always fitting in `__int128`.
+const int MAX_DIGITS = 38;
+
+__int128 Pow10(int n) {
+  static const auto table = [] {
+    std::vector<__int128> t(MAX_DIGITS + 1);
+    t[0] = 1;
+    for (int i = 1; i <= MAX_DIGITS; ++i) {
+      t[i] = t[i - 1] * 10;
+    }
+    return t;
+  }();
+  return table[n];
+}
+
+// Multiply by `10^n`, return false on overflow.
+bool Scale(__int128 &v, int n) {
+  return n <= MAX_DIGITS && !__builtin_mul_overflow(v, Pow10(n), &v);
+}
+
+}  // namespace
+
+expr::Operand DecimalSumAgg::Add(const expr::Operand &var, const expr::Tuple *tuple) const {
+  const auto &v = (*tuple)[m_index];
+  if (v == nullptr) {
+    return var;
+  }
+  if (var == nullptr) {
+    return v;
+  }
+  return expr::calc::Add(var.GetValue<types::DecimalP>(), v.GetValue<types::DecimalP>());
+}
+
+void DecimalSumAgg::Accumulate(expr::Operand &var, expr::Operand *state, const expr::Tuple *tuple) const {
+  const auto &v = (*tuple)[m_index];
+  if (v == nullptr) {
+    return;
+  }
+  Accumulator acc{0, 0, nullptr};
+  if (var != nullptr) {
+    auto low = static_cast<uint64_t>(var.GetValue<int64_t>());
+    acc.sum = static_cast<__int128>(static_cast<unsigned __int128>(state[0].GetValue<int64_t>()) << 64 | low);
+    acc.scale = state[1].GetValue<int32_t>();
+    acc.spill = std::move(state[2]);
+  }
+  AddTo(acc, v.GetValue<types::DecimalP>());
+  var = static_cast<int64_t>(acc.sum);
+  state[0] = static_cast<int64_t>(acc.sum >> 64);
+  state[1] = acc.scale;
+  state[2] = std::move(acc.spill);
+}
+
+void DecimalSumAgg::AddTo(Accumulator &acc, const types::DecimalP &v) {
+  // The value is `0.d1d2...dn * 10^exp`, i.e. the digits scaled by `n - exp`.
+  mp_exp_t exp;
+  auto str = v->getDigits(exp);
+  bool negative = !str.empty() && str[0] == '-';
+  int digits = static_cast<int>(str.size()) - negative;
+  __int128 value = 0;
+  int scale = 0;
+  bool exact = digits <= MAX_DIGITS;
+  if (exact && digits > 0) {
+    for (size_t i = negative; i < str.size(); ++i) {
+      value = value * 10 + (str[i] - '0');
+    }
+    value = negative ? -value : value;
+    scale = digits - static_cast<int>(exp);
+    if (scale < 0) {
+      exact = Scale(value, -scale);
+      scale = 0;
+    }
+  }
+  if (exact && scale > acc.scale) {
+    __int128 sum = acc.sum;
+    if (Scale(sum, scale - acc.scale)) {
+      acc.sum = sum;
+      acc.scale = scale;
+    } else {
+      exact = false;
+    }
+  } else if (exact && scale < acc.scale) {
+    exact = Scale(value, acc.scale - scale);
+  }
+  __int128 total;
+  if (exact && !__builtin_add_overflow(acc.sum, value, &total)) {
+    acc.sum = total;
+  } else if (exact) {
+    // Move the sum so far to the spill.
+    types::DecimalP sum(expr::Int128ToString(acc.sum, acc.scale));
+    acc.spill = acc.spill == nullptr ? sum : expr::calc::Add(acc.spill.GetValue<types::DecimalP>(), sum);
+    acc.sum = value;
+  } else {
+    acc.spill = acc.spill == nullptr ? v : expr::calc::Add(acc.spill.GetValue<types::DecimalP>(), v);
+  }
+}
+
+void DecimalSumAgg::Finish(expr::Operand &var, expr::Operand *state) const {
+  if (var == nullptr) {
+    return;
+  }
+  auto low = static_cast<uint64_t>(var.GetValue<int64_t>());
+  auto sum = static_cast<__int128>(static_cast<unsigned __int128>(state[0].GetValue<int64_t>()) << 64 | low);
+  types::DecimalP decimal(expr::Int128ToString(sum, state[1].GetValue<int32_t>()));
+  var = state[2] == nullptr ? decimal : expr::calc::Add(decimal, state[2].GetValue<types::DecimalP>());
+}
+
 }  // namespace dingodb::rel::op
@@ -15,9 +15,13 @@
 #ifndef _REL_OP_AGG_H_
 #define _REL_OP_AGG_H_
 
+#include <type_traits>
+#include <vector>
+
 #include "../../expr/calc/arithmetic.h"
 #include "../../expr/calc/mathematic.h"
 #include "../../expr/operand.h"
+#include "../../expr/operator_vector.h"
 
 namespace dingodb::rel::op {
 
@@ -27,6 +31,46 @@ class Agg {
   virtual ~Agg() = default;
 
   virtual expr::Operand Add(const expr::Operand &var, const expr::Tuple *tuple) const = 0;
+
+  /**
+   * @brief Get the number of the operands kept as the state of a group besides the accumulated value, which are stored
+   * after the output values in the cache of the group, so an aggregation itself holds no state of the groups.
+   */
+  virtual size_t StateSize() const {
+    return 0;
+  }
+
+  /**
+   * @brief Add a tuple to the accumulated value and the state of a group, which is `Add` if there is no state.
+   *
+   * @param var the accumulated value
+   * @param state the `StateSize()` operands of the state, initially `NULL`
+   * @param tuple the tuple
+   */
+  virtual void Accumulate(expr::Operand &var, [[maybe_unused]] expr::Operand *state, const expr::Tuple *tuple) const {
+    var = Add(var, tuple);
+  }
+
+  /**
+   * @brief Convert the accumulated value to the output value, which is called once when a group is output.
+   *
+   * @param var the accumulated value
+   * @param state the operands of the state, dropped after this call
+   */
+  virtual void Finish([[maybe_unused]] expr::Operand &var, [[maybe_unused]] expr::Operand *state) const {
+  }
+
+  virtual void GetInputVars([[maybe_unused]] std::vector<expr::VarInfo> &vars) const {
+  }
+
+  /**
+   * @brief Create the aggregation combining the output values of this one, e.g. SUM for COUNT, so the input can be
+   * aggregated in parts and the partial results aggregated again.
+   *
+   * @param index the index of the column of the partial results
+   * @return const Agg* the new aggregation, owned by the caller
+   */
+  virtual const Agg *MergeAgg(int32_t index) const = 0;
 };
 
 class UnityAgg : public Agg {
@@ -36,6 +80,10 @@ class UnityAgg : public Agg {
 
   ~UnityAgg() override = default;
 
+  void GetInputVars(std::vector<expr::VarInfo> &vars) const override {
+    expr::AddVarInfo(vars, m_index, expr::TYPE_NULL);
+  }
+
  protected:
   int32_t m_index;
 };
@@ -46,6 +94,8 @@ class CountAllAgg : public Agg {
   ~CountAllAgg() override = default;
 
   expr::Operand Add(const expr::Operand &var, const expr::Tuple *tuple) const override;
+
+  const Agg *MergeAgg(int32_t index) const override;
 };
 
 template <typename T>
@@ -65,6 +115,8 @@ class CountAgg : public UnityAgg {
     }
     return var;
   }
+
+  const Agg *MergeAgg(int32_t index) const override;
 };
 
 template <typename T, T (*Calc)(T, T)>
@@ -79,17 +131,75 @@ class CalcAgg : public UnityAgg {
     if ((*tuple)[m_index] != nullptr) {
       auto v = ((*tuple)[m_index]).template GetValue<T>();
       if (var != nullptr) {
-        return Calc(var.GetValue<T>(), v);
+        v = Calc(var.GetValue<T>(), v);
+      }
+      // The accumulated value outlives the input, e.g. MAX of strings of a column batch.
+      if constexpr (std::is_same_v<T, expr::String>) {
+        return v.Detached();
+      } else {
+        return v;
       }
-      return v;
     }
     return var;
   }
+
+  const Agg *MergeAgg(int32_t index) const override {
+    return new CalcAgg<T, Calc>(index);
+  }
 };
 
 template <typename T>
 using SumAgg = CalcAgg<T, expr::calc::Add>;
 
+template <typename T>
+const Agg *CountAgg<T>::MergeAgg(int32_t index) const {
+  return new SumAgg<int64_t>(index);
+}
+
+/**
+ * @brief SUM of decimals, accumulated exactly in 128-bit integers scaled to the largest scale of the inputs, so no
+ * decimal is created until output.
+ *
+ * The accumulator of a group is kept in its cache: the accumulated value holds the low 64 bits of the sum as `INT64`
+ * until `Finish`, and the state holds the high 64 bits, the scale and the sum of the values not accumulated exactly,
+ * i.e. inputs of more than 38 digits and the sums overflowing, which are added as decimals instead.
+ */
+class DecimalSumAgg : public UnityAgg {
+ public:
+  DecimalSumAgg(int32_t index) : UnityAgg(index) {
+  }
+
+  ~DecimalSumAgg() override = default;
+
+  // Without state, the decimals are added directly.
+  expr::Operand Add(const expr::Operand &var, const expr::Tuple *tuple) const override;
+
+  size_t StateSize() const override {
+    return STATE_SIZE;
+  }
+
+  void Accumulate(expr::Operand &var, expr::Operand *state, const expr::Tuple *tuple) const override;
+
+  void Finish(expr::Operand &var, expr::Operand *state) const override;
+
+  const Agg *MergeAgg(int32_t index) const override {
+    return new DecimalSumAgg(index);
+  }
+
+ private:
+  // The high 64 bits of the sum, the scale and the spill.
+  static const size_t STATE_SIZE = 3;
+
+  struct Accumulator {
+    __int128 sum;
+    int32_t scale;
+    // Sum of the values not accumulated in `sum`, `NULL` if none.
+    expr::Operand spill;
+  };
+
+  static void AddTo(Accumulator &acc, const types::DecimalP &v);
+};
+
 template <typename T>
 using MinAgg = CalcAgg<T, expr::calc::Min>;
 
@@ -16,7 +16,12 @@
 
 namespace dingodb::rel::op {
 
-AggOp::AggOp(const std::vector<const Agg *> *aggs) : m_aggs(aggs) {
+AggOp::AggOp(const std::vector<const Agg *> *aggs, TuplePool *pool)
+    : m_aggs(aggs), m_pool(pool), m_state_offsets(aggs->size()), m_state_size(0) {
+  for (size_t i = 0; i < aggs->size(); ++i) {
+    m_state_offsets[i] = aggs->size() + m_state_size;
+    m_state_size += (*aggs)[i]->StateSize();
+  }
 }
 
 AggOp::~AggOp() {
@@ -26,14 +31,43 @@ AggOp::~AggOp() {
   delete m_aggs;
 }
 
-void AggOp::AddToCache(expr::Tuple *&cache, const expr::Tuple *tuple) const {
+void AggOp::GetInputVars(std::vector<expr::VarInfo> &vars) const {
+  for (const auto *agg : *m_aggs) {
+    agg->GetInputVars(vars);
+  }
+}
+
+void AggOp::AddToCache(expr::Tuple *&cache, const expr::Tuple *tuple, size_t offset) const {
+  Accumulate(cache, tuple, offset);
+  m_pool->Release(tuple);
+}
+
+void AggOp::Accumulate(expr::Tuple *&cache, const expr::Tuple *tuple, size_t offset) const {
   if (cache == nullptr) {
-    cache = new expr::Tuple(m_aggs->size());
+    cache = m_pool->Acquire();
+    cache->resize(offset + m_aggs->size() + m_state_size);
   }
+  auto *vars = cache->data() + offset;
   for (int i = 0; i < m_aggs->size(); ++i) {
-    (*cache)[i] = (*m_aggs)[i]->Add((*cache)[i], tuple);
+    (*m_aggs)[i]->Accumulate(vars[i], vars + m_state_offsets[i], tuple);
+  }
+}
+
+void AggOp::Finish(expr::Tuple &cache, size_t offset) const {
+  auto *vars = cache.data() + offset;
+  for (size_t i = 0; i < m_aggs->size(); ++i) {
+    (*m_aggs)[i]->Finish(vars[i], vars + m_state_offsets[i]);
+  }
+  cache.resize(offset + m_aggs->size());
+}
+
+std::vector<const Agg *> *AggOp::MergeAggs(size_t offset) const {
+  auto *aggs = new std::vector<const Agg *>();
+  aggs->reserve(m_aggs->size());
+  for (size_t i = 0; i < m_aggs->size(); ++i) {
+    aggs->push_back((*m_aggs)[i]->MergeAgg(static_cast<int32_t>(offset + i)));
   }
-  delete tuple;
+  return aggs;
 }
 
 }  // namespace dingodb::rel::op
@@ -15,6 +15,7 @@
 #ifndef _REL_OP_AGG_OP_H_
 #define _REL_OP_AGG_OP_H_
 
+#include "../tuple_pool.h"
 #include "agg.h"
 #include "rel_op.h"
 
@@ -22,15 +23,56 @@ namespace dingodb::rel::op {
 
 class AggOp : public RelOp {
  protected:
-  AggOp(const std::vector<const Agg *> *aggs);
+  AggOp(const std::vector<const Agg *> *aggs, TuplePool *pool);
 
  public:
   ~AggOp() override;
 
+  void GetInputVars(std::vector<expr::VarInfo> &vars) const override;
+
+  /**
+   * @brief Create the operator aggregating the outputs of this one again, to combine the partial results of the input
+   * aggregated in parts. Its outputs are the same as aggregating the whole input by this operator.
+   *
+   * @param pool the tuple pool of the new operator
+   * @return AggOp* the new operator, owned by the caller
+   */
+  virtual AggOp *CreateMergeOp(TuplePool *pool) const = 0;
+
  protected:
   const std::vector<const Agg *> *m_aggs;
+  TuplePool *m_pool;
+  // Positions of the states of the aggregations, following the aggregations in a cache, and the total size of them.
+  std::vector<size_t> m_state_offsets;
+  size_t m_state_size;
+
+  void AddToCache(expr::Tuple *&cache, const expr::Tuple *tuple, size_t offset = 0) const;
+
+  /**
+   * @brief Accumulate a tuple into the cache, which is created if it is `nullptr`, with the states of the aggregations
+   * following the accumulated values.
+   *
+   * @param cache the cache
+   * @param tuple the tuple
+   * @param offset the position of the first aggregation in the cache
+   */
+  void Accumulate(expr::Tuple *&cache, const expr::Tuple *tuple, size_t offset = 0) const;
+
+  /**
+   * @brief Convert the accumulated values of a cache to the output values, and drop the states, before it is output.
+   *
+   * @param cache the cache
+   * @param offset the position of the first aggregation in the cache
+   */
+  void Finish(expr::Tuple &cache, size_t offset = 0) const;
 
-  void AddToCache(expr::Tuple *&cache, const expr::Tuple *tuple) const;
+  /**
+   * @brief Create the aggregations combining the partial results of `m_aggs`, as `Agg::MergeAgg`.
+   *
+   * @param offset the position of the first aggregation in the outputs
+   * @return std::vector<const Agg *>* the new aggregations, owned by the caller
+   */
+  std::vector<const Agg *> *MergeAggs(size_t offset) const;
 };
 
 }  // namespace dingodb::rel::op
@@ -19,22 +19,58 @@
 
 namespace dingodb::rel::op {
 
-FilterOp::FilterOp(const expr::Runner *filter) : m_filter(filter) {
+FilterOp::FilterOp(const expr::Runner *filter, TuplePool *pool) : m_filter(filter), m_pool(pool) {
+  m_stats.name = "FILTER";
 }
 
 FilterOp::~FilterOp() {
   delete m_filter;
 }
 
-const expr::Tuple *FilterOp::Put(const expr::Tuple *tuple) const {
-  m_filter->BindTuple(tuple);
+TuplePtr FilterOp::Put(TuplePtr tuple) const {
+  OpTimer timer(m_stats, m_timing);
+  ++m_stats.rows_in;
+  m_filter->BindTuple(tuple.get());
   m_filter->Run();
   auto v = m_filter->Get();
   if (expr::calc::IsTrue<bool>(v)) {
+    ++m_stats.rows_out;
     return tuple;
   }
-  delete tuple;
+  m_pool->Release(tuple.release());
   return nullptr;
 }
 
+void FilterOp::Put(Batch &batch) const {
+  OpTimer timer(m_stats, m_timing);
+  auto &selection = batch.GetSelection();
+  size_t count = 0;
+  for (auto i : selection) {
+    m_filter->BindTuple(batch.GetTuple(i));
+    m_filter->Run();
+    if (expr::calc::IsTrue<bool>(m_filter->Get())) {
+      selection[count++] = i;
+    }
+  }
+  m_stats.rows_in += selection.size();
+  m_stats.rows_out += count;
+  selection.resize(count);
+}
+
+bool FilterOp::Test(const expr::Tuple &tuple) const {
+  m_filter->BindTuple(&tuple);
+  m_filter->Run();
+  return expr::calc::IsTrue<bool>(m_filter->Get());
+}
+
+std::vector<const expr::Operator *> FilterOp::GetSelectConjuncts() const {
+  return m_filter->GetSelectConjuncts();
+}
+
+void FilterOp::GetInputVars(std::vector<expr::VarInfo> &vars) const {
+  for (const auto &var : m_filter->GetVars()) {
+    expr::AddVarInfo(vars, var.index, var.type);
+  }
+}
+
 }  // namespace dingodb::rel::op
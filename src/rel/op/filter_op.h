@@ -15,24 +15,62 @@
 #ifndef _REL_OP_FILTER_OP_H_
 #define _REL_OP_FILTER_OP_H_
 
+#include "../tuple_pool.h"
 #include "rel_op.h"
 
 namespace dingodb::expr {
 class Runner;
+class Operator;
 }
 
 namespace dingodb::rel::op {
 
 class FilterOp : public RelOp {
  public:
-  FilterOp(const expr::Runner *filter);
+  FilterOp(const expr::Runner *filter, TuplePool *pool);
 
   ~FilterOp() override;
 
-  const expr::Tuple *Put(const expr::Tuple *tuple) const override;
+  TuplePtr Put(TuplePtr tuple) const override;
+
+  void Put(Batch &batch) const override;
+
+  void GetInputVars(std::vector<expr::VarInfo> &vars) const override;
+
+  bool PassesThrough() const override {
+    return true;
+  }
+
+  /**
+   * @brief Evaluate the filter on a tuple, which is not counted in the statistics.
+   *
+   * @param tuple the tuple
+   * @return true if the tuple passes
+   */
+  bool Test(const expr::Tuple &tuple) const;
+
+  /**
+   * @brief Get the comparisons of variables with constants, if the filter is a conjunction of them, so it can be
+   * evaluated over columns (see `expr::Runner::GetSelectConjuncts`).
+   *
+   * @return std::vector<const expr::Operator *> the comparisons, empty if the filter is not such a conjunction
+   */
+  std::vector<const expr::Operator *> GetSelectConjuncts() const;
+
+  /**
+   * @brief Count rows filtered without putting them, e.g. by testing the entries of a dictionary.
+   *
+   * @param rows_in number of the input rows
+   * @param rows_out number of the rows passed
+   */
+  void Count(uint64_t rows_in, uint64_t rows_out) const {
+    m_stats.rows_in += rows_in;
+    m_stats.rows_out += rows_out;
+  }
 
  private:
   const expr::Runner *m_filter;
+  TuplePool *m_pool;
 };
 
 }  // namespace dingodb::rel::op
@@ -14,14 +14,38 @@
 
 #include "grouped_agg_op.h"
 
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
 #include "../../expr/utils.h"
 
 namespace dingodb::rel::op {
 
-GroupedAggOp::GroupedAggOp(const int *group_indices, size_t group_indices_size, const std::vector<const Agg *> *aggs)
-    : AggOp(aggs)
+GroupedAggOp::GroupedAggOp(
+    const int *group_indices,
+    size_t group_indices_size,
+    const std::vector<const Agg *> *aggs,
+    TuplePool *pool
+)
+    : AggOp(aggs, pool)
     , m_group_indices(group_indices)
-    , m_groupe_indices_size(group_indices_size) {
+    , m_groupe_indices_size(group_indices_size)
+    , m_draining(false)
+    , m_movable_keys(group_indices_size, true)
+    , m_dictionaries(group_indices_size)
+    , m_bytes(0) {
+  m_stats.name = "GROUPED_AGG";
+  std::vector<expr::VarInfo> vars;
+  AggOp::GetInputVars(vars);
+  for (size_t i = 0; i < group_indices_size; ++i) {
+    auto index = group_indices[i];
+    bool read = std::count(group_indices, group_indices + group_indices_size, index) > 1;
+    for (const auto &var : vars) {
+      read = read || var.index == index;
+    }
+    m_movable_keys[i] = !read;
+  }
 }
 
 GroupedAggOp::~GroupedAggOp() {
@@ -31,23 +55,171 @@ GroupedAggOp::~GroupedAggOp() {
   }
 }
 
-const expr::Tuple *GroupedAggOp::Put(const expr::Tuple *tuple) const {
-  auto *key = expr::MapTuple(*tuple, m_group_indices, m_groupe_indices_size);
-  auto *&cache = m_caches[*key];
-  delete key;
-  AddToCache(cache, tuple);
+template <typename T>
+expr::Tuple *&GroupedAggOp::GetCache(T &tuple) const {
+  m_key.resize(m_groupe_indices_size);
+  for (size_t i = 0; i < m_groupe_indices_size; ++i) {
+    auto &v = tuple[m_group_indices[i]];
+    if (m_dictionaries[i] != nullptr && v.GetType() == expr::TYPE_STRING) {
+      m_key[i] = m_dictionaries[i]->Encode(v.template GetValue<expr::String>());
+      continue;
+    }
+    if constexpr (!std::is_const_v<T>) {
+      if (m_movable_keys[i]) {
+        m_key[i] = std::move(v);
+        continue;
+      }
+    }
+    m_key[i] = v;
+  }
+  m_draining = false;
+  auto it = m_caches.find(m_key);
+  if (it == m_caches.end()) {
+    // The key outlives the input, so it must not hold a slice of it, e.g. of a column batch.
+    for (auto &v : m_key) {
+      if (v.GetType() == expr::TYPE_STRING) {
+        v = v.GetValue<expr::String>().Detached();
+      }
+    }
+    it = m_caches.emplace(std::move(m_key), nullptr).first;
+    m_bytes += EntryBytes(it->first);
+    UpdatePeakBytes();
+  }
+  // The cache is created by `Accumulate`, with the keys left `NULL` until drained.
+  return it->second;
+}
+
+TuplePtr GroupedAggOp::Put(TuplePtr tuple) const {
+  OpTimer timer(m_stats, m_timing);
+  ++m_stats.rows_in;
+  auto *&cache = GetCache(*tuple);
+  AddToCache(cache, tuple.release(), m_groupe_indices_size);
+  return nullptr;
+}
+
+void GroupedAggOp::Put(Batch &batch) const {
+  OpTimer timer(m_stats, m_timing);
+  auto &selection = batch.GetSelection();
+  m_stats.rows_in += selection.size();
+  for (auto i : selection) {
+    const auto *tuple = batch.GetTuple(i);
+    Accumulate(GetCache(*tuple), tuple, m_groupe_indices_size);
+  }
+  selection.clear();
+}
+
+Dictionary *GroupedAggOp::EncodeKey(int32_t column) {
+  for (size_t i = 0; i < m_groupe_indices_size; ++i) {
+    if (m_group_indices[i] != column || !m_movable_keys[i]) {
+      continue;
+    }
+    if (m_dictionaries[i] == nullptr && m_caches.empty()) {
+      m_dictionaries[i] = std::make_unique<Dictionary>();
+    }
+    return m_dictionaries[i].get();
+  }
   return nullptr;
 }
 
-const expr::Tuple *GroupedAggOp::Get() const {
-  if (!m_caches.empty()) {
-    auto i = m_caches.begin();
-    auto *tuple = expr::ConcatTuple(i->first, *(i->second));
-    delete i->second;
-    m_caches.erase(i);
-    return tuple;
+void GroupedAggOp::GetInputVars(std::vector<expr::VarInfo> &vars) const {
+  for (size_t i = 0; i < m_groupe_indices_size; ++i) {
+    expr::AddVarInfo(vars, m_group_indices[i], expr::TYPE_NULL);
   }
+  AggOp::GetInputVars(vars);
+}
+
+expr::Tuple *GroupedAggOp::NextDrained() const {
+  if (!m_draining) {
+    // Taken before the table is freed, but walking the buckets only if the probe lengths are enabled.
+    FillTableStats(m_stats, m_probe_stats);
+    m_drain_it = m_caches.begin();
+    m_draining = true;
+  }
+  while (m_drain_it != m_caches.end()) {
+    // Take the node out of the table, so the key can be moved into the output.
+    auto node = m_caches.extract(m_drain_it++);
+    m_bytes -= EntryBytes(node.key());
+    auto *cache = node.mapped();
+    if (cache != nullptr) {
+      auto &key = node.key();
+      for (size_t i = 0; i < m_groupe_indices_size; ++i) {
+        auto &v = key[i];
+        if (m_dictionaries[i] != nullptr && v != nullptr) {
+          (*cache)[i] = m_dictionaries[i]->Decode(v.GetValue<int64_t>());
+        } else {
+          (*cache)[i] = std::move(v);
+        }
+      }
+      Finish(*cache, m_groupe_indices_size);
+      ++m_stats.rows_out;
+      return cache;
+    }
+  }
+  // Free the whole table.
+  decltype(m_caches)().swap(m_caches);
+  m_bytes = 0;
+  m_draining = false;
   return nullptr;
 }
 
+TuplePtr GroupedAggOp::Get() const {
+  OpTimer timer(m_stats, m_timing);
+  return TuplePtr(NextDrained());
+}
+
+void GroupedAggOp::Drain(Batch &batch, size_t count) const {
+  OpTimer timer(m_stats, m_timing);
+  auto &tuples = batch.Reset(count);
+  size_t n = 0;
+  for (expr::Tuple *cache; n < count && (cache = NextDrained()) != nullptr; ++n) {
+    tuples[n].swap(*cache);
+    m_pool->Release(cache);
+  }
+  batch.Truncate(n);
+}
+
+void GroupedAggOp::GetStats(std::vector<OpStats> &stats) const {
+  stats.push_back(m_stats);
+  if (!m_draining && !m_caches.empty()) {
+    FillTableStats(stats.back(), true);
+  }
+}
+
+void GroupedAggOp::FillTableStats(OpStats &stats, bool probes) const {
+  stats.groups = m_caches.size();
+  stats.buckets = m_caches.bucket_count();
+  stats.load_factor = m_caches.load_factor();
+  if (!probes) {
+    return;
+  }
+  // Finding the i-th entry of a bucket visits i entries.
+  uint64_t total = 0;
+  uint64_t max_probe_length = 0;
+  for (size_t b = 0; b < m_caches.bucket_count(); ++b) {
+    uint64_t size = m_caches.bucket_size(b);
+    total += size * (size + 1) / 2;
+    max_probe_length = std::max(max_probe_length, size);
+  }
+  stats.mean_probe_length = m_caches.empty() ? 0.0 : static_cast<double>(total) / m_caches.size();
+  stats.max_probe_length = max_probe_length;
+}
+
+uint64_t GroupedAggOp::EntryBytes(const expr::Tuple &key) const {
+  // The node of the table with the key, and the output row.
+  return sizeof(void *) * 2 + sizeof(decltype(m_caches)::value_type) + key.capacity() * sizeof(expr::Operand) +
+         sizeof(expr::Tuple) + (m_groupe_indices_size + m_aggs->size() + m_state_size) * sizeof(expr::Operand);
+}
+
+void GroupedAggOp::UpdatePeakBytes() const {
+  m_stats.peak_bytes = std::max(m_stats.peak_bytes, m_bytes + m_caches.bucket_count() * sizeof(void *));
+}
+
+AggOp *GroupedAggOp::CreateMergeOp(TuplePool *pool) const {
+  auto *group_indices = new int[m_groupe_indices_size];
+  for (size_t i = 0; i < m_groupe_indices_size; ++i) {
+    group_indices[i] = static_cast<int>(i);
+  }
+  return new GroupedAggOp(group_indices, m_groupe_indices_size, MergeAggs(m_groupe_indices_size), pool);
+}
+
 }  // namespace dingodb::rel::op
@@ -15,8 +15,10 @@
 #ifndef _REL_OP_GROUPED_AGG_OP_H_
 #define _REL_OP_GROUPED_AGG_OP_H_
 
+#include <memory>
 #include <unordered_map>
 
+#include "../dictionary.h"
 #include "agg.h"
 #include "agg_op.h"
 
@@ -24,19 +26,90 @@ namespace dingodb::rel::op {
 
 class GroupedAggOp : public AggOp {
  public:
-  GroupedAggOp(const int *group_indices, size_t group_indices_size, const std::vector<const Agg *> *aggs);
+  GroupedAggOp(
+      const int *group_indices,
+      size_t group_indices_size,
+      const std::vector<const Agg *> *aggs,
+      TuplePool *pool
+  );
 
   ~GroupedAggOp() override;
 
-  const expr::Tuple *Put(const expr::Tuple *tuple) const override;
+  TuplePtr Put(TuplePtr tuple) const override;
 
-  const expr::Tuple *Get() const override;
+  void Put(Batch &batch) const override;
+
+  TuplePtr Get() const override;
+
+  void Drain(Batch &batch, size_t count) const override;
+
+  void GetInputVars(std::vector<expr::VarInfo> &vars) const override;
+
+  AggOp *CreateMergeOp(TuplePool *pool) const override;
+
+  void GetStats(std::vector<OpStats> &stats) const override;
+
+  /**
+   * @brief Group on the codes of a string key column instead of the strings, which are decoded only for the output.
+   *
+   * String values of the column are encoded by the returned dictionary when put, but the caller may also put the
+   * `int64_t` codes directly, e.g. translated once per entry of the dictionary of a column batch. Only a key column
+   * not read by the aggregations can be encoded, and only before any group is created.
+   *
+   * @param column index of the column in the input tuples
+   * @return Dictionary* the dictionary of the column, or `nullptr` if the column cannot be encoded
+   */
+  Dictionary *EncodeKey(int32_t column);
 
  private:
   const int *m_group_indices;
   size_t m_groupe_indices_size;
 
+  // The values are the output tuples, i.e. the keys followed by the aggregations. The keys are `NULL` until drained,
+  // when they are moved in from the table, so a key is stored only once.
   mutable std::unordered_map<expr::Tuple, expr::Tuple *, std::hash<expr::Tuple>> m_caches;
+  // Draining takes the caches out of the table one by one, and frees the buckets at the end.
+  mutable bool m_draining;
+  mutable std::unordered_map<expr::Tuple, expr::Tuple *, std::hash<expr::Tuple>>::iterator m_drain_it;
+  // Whether a key column can be moved out of an owned input, i.e. it is not read by the aggregations.
+  std::vector<bool> m_movable_keys;
+  // Dictionaries of the key columns grouped on codes, `nullptr` for other keys.
+  std::vector<std::unique_ptr<Dictionary>> m_dictionaries;
+  // Reused to look up the caches, so a key is stored only for a new group.
+  mutable expr::Tuple m_key;
+  // Estimated bytes of the entries of the table, kept as groups are added and drained.
+  mutable uint64_t m_bytes;
+
+  /**
+   * @brief Get the cache of the group of a tuple. The key columns are moved out of the tuple if it is not const.
+   */
+  template <typename T>
+  expr::Tuple *&GetCache(T &tuple) const;
+
+  /**
+   * @brief Get the next cache in draining, which is taken out of the table.
+   *
+   * @return expr::Tuple* the cache, or `nullptr` if the draining is finished
+   */
+  expr::Tuple *NextDrained() const;
+
+  /**
+   * @brief Fill the metrics of the hash table into the statistics.
+   *
+   * @param stats the statistics
+   * @param probes whether to also fill the probe lengths, which walks all the buckets
+   */
+  void FillTableStats(OpStats &stats, bool probes) const;
+
+  /**
+   * @brief Get the estimated bytes of an entry of the table, i.e. the node with the key and the output row.
+   */
+  uint64_t EntryBytes(const expr::Tuple &key) const;
+
+  /**
+   * @brief Update the peak bytes with the entries and the buckets of the table, as a group is added.
+   */
+  void UpdatePeakBytes() const;
 };
 
 }  // namespace dingodb::rel::op
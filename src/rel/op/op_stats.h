@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _REL_OP_OP_STATS_H_
+#define _REL_OP_OP_STATS_H_
+
+#include <chrono>
+#include <cstdint>
+
+namespace dingodb::rel {
+
+/**
+ * @brief Execution statistics of an operator.
+ */
+struct OpStats {
+  const char *name = "";
+  uint64_t rows_in = 0;
+  uint64_t rows_out = 0;
+  // Time spent in the operator, only collected if timing is enabled.
+  uint64_t nanos = 0;
+  // Metrics of the hash table, only for grouped aggregation.
+  uint64_t groups = 0;
+  uint64_t buckets = 0;
+  double load_factor = 0.0;
+  // Mean number of the entries visited to find an existing group. The probe lengths walk all the buckets, so they are
+  // kept after the table is drained only if enabled by `EnableProbeStats`.
+  double mean_probe_length = 0.0;
+  uint64_t max_probe_length = 0;
+  // Estimated peak bytes of the states held by the operator, updated as the states grow.
+  uint64_t peak_bytes = 0;
+
+  /**
+   * @brief Get the ratio of the output rows to the input rows.
+   *
+   * @return double the selectivity, 1.0 if there are no input rows
+   */
+  double Selectivity() const {
+    return rows_in > 0 ? static_cast<double>(rows_out) / static_cast<double>(rows_in) : 1.0;
+  }
+};
+
+/**
+ * @brief Add the time of a scope to the statistics, if enabled.
+ */
+class OpTimer {
+ public:
+  OpTimer(OpStats &stats, bool enabled) : m_stats(enabled ? &stats : nullptr) {
+    if (m_stats != nullptr) {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~OpTimer() {
+    if (m_stats != nullptr) {
+      auto elapsed = std::chrono::steady_clock::now() - m_start;
+      m_stats->nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+  }
+
+  OpTimer(const OpTimer &) = delete;
+  OpTimer &operator=(const OpTimer &) = delete;
+
+ private:
+  OpStats *m_stats;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace dingodb::rel
+
+#endif /* _REL_OP_OP_STATS_H_ */
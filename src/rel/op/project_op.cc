@@ -14,22 +14,103 @@
 
 #include "project_op.h"
 
+#include <algorithm>
+
 #include "../../expr/runner.h"
 
 namespace dingodb::rel::op {
 
-ProjectOp::ProjectOp(const expr::Runner *projects) : m_projects(projects) {
+ProjectOp::ProjectOp(expr::Runner *projects) : m_projects(projects) {
+  m_stats.name = "PROJECT";
+  m_pass_throughs = projects->RemovePassThroughs();
+  bool any = false;
+  m_movable.resize(m_pass_throughs.size(), false);
+  for (size_t i = 0; i < m_pass_throughs.size(); ++i) {
+    auto index = m_pass_throughs[i];
+    if (index >= 0) {
+      any = true;
+      m_movable[i] = std::count(m_pass_throughs.begin(), m_pass_throughs.end(), index) == 1;
+    }
+  }
+  if (!any) {
+    m_pass_throughs.clear();
+  }
 }
 
 ProjectOp::~ProjectOp() {
   delete m_projects;
 }
 
-const expr::Tuple *ProjectOp::Put(const expr::Tuple *tuple) const {
-  m_projects->BindTuple(tuple);
+void ProjectOp::Project(expr::Tuple &output, const expr::Tuple &input) const {
+  if (m_pass_throughs.empty()) {
+    m_projects->GetAll(output);
+    return;
+  }
+  m_projects->GetAll(m_values);
+  output.resize(m_pass_throughs.size());
+  size_t j = 0;
+  for (size_t i = 0; i < m_pass_throughs.size(); ++i) {
+    auto index = m_pass_throughs[i];
+    if (index < 0) {
+      output[i] = std::move(m_values[j++]);
+    } else {
+      output[i] = input[index];
+    }
+  }
+}
+
+void ProjectOp::Project(expr::Tuple &output, expr::Tuple &&input) const {
+  if (m_pass_throughs.empty()) {
+    m_projects->GetAll(output);
+    return;
+  }
+  m_projects->GetAll(m_values);
+  output.resize(m_pass_throughs.size());
+  size_t j = 0;
+  for (size_t i = 0; i < m_pass_throughs.size(); ++i) {
+    auto index = m_pass_throughs[i];
+    if (index < 0) {
+      output[i] = std::move(m_values[j++]);
+    } else if (m_movable[i]) {
+      output[i] = std::move(input[index]);
+    } else {
+      output[i] = input[index];
+    }
+  }
+}
+
+TuplePtr ProjectOp::Put(TuplePtr tuple) const {
+  OpTimer timer(m_stats, m_timing);
+  ++m_stats.rows_in;
+  ++m_stats.rows_out;
+  m_projects->BindTuple(tuple.get());
   m_projects->Run();
-  delete tuple;
-  return m_projects->GetAll();
+  // The storage of the input tuple is reused for the output.
+  Project(m_output, std::move(*tuple));
+  tuple->swap(m_output);
+  m_output.clear();
+  return tuple;
+}
+
+void ProjectOp::Put(Batch &batch) const {
+  OpTimer timer(m_stats, m_timing);
+  const auto &selection = batch.GetSelection();
+  m_stats.rows_in += selection.size();
+  m_stats.rows_out += selection.size();
+  auto &outputs = batch.PrepareOutputs();
+  for (size_t i = 0; i < selection.size(); ++i) {
+    const auto *tuple = batch.GetTuple(selection[i]);
+    m_projects->BindTuple(tuple);
+    m_projects->Run();
+    Project(outputs[i], *tuple);
+  }
+  batch.ReplaceWithOutputs();
+}
+
+void ProjectOp::GetInputVars(std::vector<expr::VarInfo> &vars) const {
+  for (const auto &var : m_projects->GetVars()) {
+    expr::AddVarInfo(vars, var.index, var.type);
+  }
 }
 
 }  // namespace dingodb::rel::op
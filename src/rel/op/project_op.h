@@ -15,6 +15,8 @@
 #ifndef _REL_OP_PROJECT_OP_H_
 #define _REL_OP_PROJECT_OP_H_
 
+#include <vector>
+
 #include "rel_op.h"
 
 namespace dingodb::expr {
@@ -25,14 +27,49 @@ namespace dingodb::rel::op {
 
 class ProjectOp : public RelOp {
  public:
-  ProjectOp(const expr::Runner *projects);
+  /**
+   * @brief Construct a new Project Op object. Projections which are plain variables are removed from the runner and
+   * taken from the input tuples directly.
+   *
+   * @param projects the runner of the projections
+   */
+  ProjectOp(expr::Runner *projects);
 
   ~ProjectOp() override;
 
-  const expr::Tuple *Put(const expr::Tuple *tuple) const override;
+  TuplePtr Put(TuplePtr tuple) const override;
+
+  void Put(Batch &batch) const override;
+
+  void GetInputVars(std::vector<expr::VarInfo> &vars) const override;
 
  private:
   const expr::Runner *m_projects;
+  // For each projection, the index of the input column if it is a plain variable, or -1.
+  std::vector<int32_t> m_pass_throughs;
+  // Whether a pass-through column can be moved from an owned input, i.e. it is not passed through more than once.
+  std::vector<bool> m_movable;
+
+  // Buffers reused between rows.
+  mutable expr::Tuple m_values;
+  mutable expr::Tuple m_output;
+
+  /**
+   * @brief Write the projected values of the last run into the output tuple, copying the pass-through columns.
+   *
+   * @param output the output tuple
+   * @param input the input tuple
+   */
+  void Project(expr::Tuple &output, const expr::Tuple &input) const;
+
+  /**
+   * @brief Write the projected values of the last run into the output tuple, moving the pass-through columns if
+   * possible.
+   *
+   * @param output the output tuple
+   * @param input the input tuple
+   */
+  void Project(expr::Tuple &output, expr::Tuple &&input) const;
 };
 
 }  // namespace dingodb::rel::op
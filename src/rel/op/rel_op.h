@@ -15,20 +15,106 @@
 #ifndef _REL_OP_REL_OP_H_
 #define _REL_OP_REL_OP_H_
 
+#include <memory>
+#include <vector>
+
 #include "../../expr/operand.h"
+#include "../../expr/operator_vector.h"
+#include "../batch.h"
+#include "op_stats.h"
 
 namespace dingodb::rel {
 
+using TuplePtr = std::unique_ptr<expr::Tuple>;
+
 class RelOp {
  public:
   RelOp() = default;
   virtual ~RelOp() = default;
 
-  virtual const expr::Tuple *Put(const expr::Tuple *tuple) const = 0;
+  /**
+   * @brief Put a tuple, which is moved into the operator.
+   *
+   * @param tuple the tuple
+   * @return TuplePtr the output tuple, or `nullptr` if there is none
+   */
+  virtual TuplePtr Put(TuplePtr tuple) const = 0;
 
-  virtual const expr::Tuple *Get() const {
+  /**
+   * @brief Put a batch of tuples, which are borrowed, i.e. not moved or released.
+   *
+   * On return, the selected tuples of the batch are the output.
+   *
+   * @param batch the batch
+   */
+  virtual void Put(Batch &batch) const = 0;
+
+  virtual TuplePtr Get() const {
     return nullptr;
   }
+
+  /**
+   * @brief Get output tuples in a batch, after all the tuples are put. The batch is reset with tuples owned by it.
+   *
+   * @param batch the batch, which is empty if there are no more outputs
+   * @param count max number of the tuples
+   */
+  virtual void Drain(Batch &batch, size_t count) const {
+    auto &tuples = batch.Reset(count);
+    size_t n = 0;
+    for (TuplePtr tuple; n < count && (tuple = Get()) != nullptr; ++n) {
+      tuples[n].swap(*tuple);
+    }
+    batch.Truncate(n);
+  }
+
+  /**
+   * @brief Get the variables of the input tuples read by the operator.
+   *
+   * @param vars the variables, to which new ones are appended in the order of first use
+   */
+  virtual void GetInputVars(std::vector<expr::VarInfo> &vars) const = 0;
+
+  /**
+   * @brief Whether the output tuples are the input ones, so the variables read by the following operator are also
+   * read from the input tuples.
+   */
+  virtual bool PassesThrough() const {
+    return false;
+  }
+
+  /**
+   * @brief Get the statistics of the operator.
+   *
+   * @param stats the statistics, to which those of the operator (and its children) are appended
+   */
+  virtual void GetStats(std::vector<OpStats> &stats) const {
+    stats.push_back(m_stats);
+  }
+
+  /**
+   * @brief Enable or disable timing of the operator (and its children), which costs two reads of the clock per call.
+   *
+   * @param enabled true to enable
+   */
+  virtual void EnableTiming(bool enabled) {
+    m_timing = enabled;
+  }
+
+  /**
+   * @brief Enable or disable collecting the probe lengths of hash tables of the operator (and its children), which
+   * walks all the buckets of a table before it is drained.
+   *
+   * @param enabled true to enable
+   */
+  virtual void EnableProbeStats(bool enabled) {
+    m_probe_stats = enabled;
+  }
+
+ protected:
+  mutable OpStats m_stats;
+  bool m_timing = false;
+  bool m_probe_stats = false;
 };
 
 }  // namespace dingodb::rel
@@ -16,7 +16,7 @@
 
 namespace dingodb::rel::op {
 
-TandemOp::TandemOp(const RelOp *in, const RelOp *out) : m_in(in), m_out(out) {
+TandemOp::TandemOp(RelOp *in, RelOp *out) : m_in(in), m_out(out) {
 }
 
 TandemOp::~TandemOp() {
@@ -24,18 +24,46 @@ TandemOp::~TandemOp() {
   delete m_out;
 }
 
-const expr::Tuple *TandemOp::Put(const expr::Tuple *tuple) const {
-  const auto *t = m_in->Put(tuple);
+TuplePtr TandemOp::Put(TuplePtr tuple) const {
+  auto t = m_in->Put(std::move(tuple));
   if (t != nullptr) {
-    return m_out->Put(t);
+    return m_out->Put(std::move(t));
   }
   return nullptr;
 }
 
-const expr::Tuple *TandemOp::Get() const {
-  const expr::Tuple *tuple;
+void TandemOp::Put(Batch &batch) const {
+  m_in->Put(batch);
+  if (!batch.Empty()) {
+    m_out->Put(batch);
+  }
+}
+
+void TandemOp::GetInputVars(std::vector<expr::VarInfo> &vars) const {
+  m_in->GetInputVars(vars);
+  if (m_in->PassesThrough()) {
+    m_out->GetInputVars(vars);
+  }
+}
+
+void TandemOp::Drain(Batch &batch, size_t count) const {
+  while (true) {
+    m_in->Drain(batch, count);
+    if (batch.Size() == 0) {
+      break;
+    }
+    m_out->Put(batch);
+    if (!batch.Empty()) {
+      return;
+    }
+  }
+  m_out->Drain(batch, count);
+}
+
+TuplePtr TandemOp::Get() const {
+  TuplePtr tuple;
   while ((tuple = m_in->Get()) != nullptr) {
-    const auto *t = m_out->Put(tuple);
+    auto t = m_out->Put(std::move(tuple));
     if (t != nullptr) {
       return t;
     }
@@ -21,16 +21,42 @@ namespace dingodb::rel::op {
 
 class TandemOp : public RelOp {
  public:
-  TandemOp(const RelOp *in, const RelOp *out);
+  TandemOp(RelOp *in, RelOp *out);
 
   ~TandemOp() override;
 
-  const expr::Tuple *Put(const expr::Tuple *tuple) const override;
-  const expr::Tuple *Get() const override;
+  TuplePtr Put(TuplePtr tuple) const override;
+
+  void Put(Batch &batch) const override;
+
+  void GetInputVars(std::vector<expr::VarInfo> &vars) const override;
+
+  bool PassesThrough() const override {
+    return m_in->PassesThrough() && m_out->PassesThrough();
+  }
+
+  TuplePtr Get() const override;
+
+  void Drain(Batch &batch, size_t count) const override;
+
+  void GetStats(std::vector<OpStats> &stats) const override {
+    m_in->GetStats(stats);
+    m_out->GetStats(stats);
+  }
+
+  void EnableTiming(bool enabled) override {
+    m_in->EnableTiming(enabled);
+    m_out->EnableTiming(enabled);
+  }
+
+  void EnableProbeStats(bool enabled) override {
+    m_in->EnableProbeStats(enabled);
+    m_out->EnableProbeStats(enabled);
+  }
 
  private:
-  const RelOp *m_in;
-  const RelOp *m_out;
+  RelOp *m_in;
+  RelOp *m_out;
 };
 
 }  // namespace dingodb::rel::op
@@ -14,27 +14,50 @@
 
 #include "ungrouped_agg_op.h"
 
+#include <algorithm>
+
 namespace dingodb::rel::op {
 
-UngroupedAggOp::UngroupedAggOp(const std::vector<const Agg *> *aggs) : AggOp(aggs), m_cache(nullptr) {
+UngroupedAggOp::UngroupedAggOp(const std::vector<const Agg *> *aggs, TuplePool *pool)
+    : AggOp(aggs, pool), m_cache(nullptr) {
+  m_stats.name = "UNGROUPED_AGG";
 }
 
 UngroupedAggOp::~UngroupedAggOp() {
   delete m_cache;
 }
 
-const expr::Tuple *UngroupedAggOp::Put(const expr::Tuple *tuple) const {
-  AddToCache(m_cache, tuple);
+TuplePtr UngroupedAggOp::Put(TuplePtr tuple) const {
+  OpTimer timer(m_stats, m_timing);
+  ++m_stats.rows_in;
+  AddToCache(m_cache, tuple.release());
   return nullptr;
 }
 
-const expr::Tuple *UngroupedAggOp::Get() const {
-  if (m_cache != nullptr) {
-    auto *p = m_cache;
-    m_cache = nullptr;
-    return p;
+void UngroupedAggOp::Put(Batch &batch) const {
+  OpTimer timer(m_stats, m_timing);
+  auto &selection = batch.GetSelection();
+  m_stats.rows_in += selection.size();
+  for (auto i : selection) {
+    Accumulate(m_cache, batch.GetTuple(i));
   }
-  return nullptr;
+  selection.clear();
+}
+
+TuplePtr UngroupedAggOp::Get() const {
+  TuplePtr p(m_cache);
+  m_cache = nullptr;
+  if (p != nullptr) {
+    Finish(*p);
+    uint64_t bytes = sizeof(expr::Tuple) + p->capacity() * sizeof(expr::Operand);
+    m_stats.peak_bytes = std::max(m_stats.peak_bytes, bytes);
+    ++m_stats.rows_out;
+  }
+  return p;
+}
+
+AggOp *UngroupedAggOp::CreateMergeOp(TuplePool *pool) const {
+  return new UngroupedAggOp(MergeAggs(0), pool);
 }
 
 }  // namespace dingodb::rel::op
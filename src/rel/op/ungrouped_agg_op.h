@@ -22,13 +22,17 @@ namespace dingodb::rel::op {
 
 class UngroupedAggOp : public AggOp {
  public:
-  UngroupedAggOp(const std::vector<const Agg *> *aggs);
+  UngroupedAggOp(const std::vector<const Agg *> *aggs, TuplePool *pool);
 
   ~UngroupedAggOp() override;
 
-  const expr::Tuple *Put(const expr::Tuple *tuple) const override;
+  TuplePtr Put(TuplePtr tuple) const override;
 
-  const expr::Tuple *Get() const override;
+  void Put(Batch &batch) const override;
+
+  TuplePtr Get() const override;
+
+  AggOp *CreateMergeOp(TuplePool *pool) const override;
 
  private:
   mutable expr::Tuple *m_cache;
@@ -0,0 +1,195 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "parallel_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+#include "op/agg_op.h"
+
+namespace dingodb::rel {
+
+ParallelRunner::ParallelRunner(size_t threads) : m_output(0), m_offset(0), m_pending(0), m_stopping(false) {
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  m_workers.resize(threads);
+  m_threads.reserve(threads - 1);
+  for (size_t n = 1; n < threads; ++n) {
+    m_threads.emplace_back(&ParallelRunner::Loop, this);
+  }
+}
+
+ParallelRunner::~ParallelRunner() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_queued.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+void ParallelRunner::Loop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_queued.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+      if (m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_pending == 0) {
+      m_finished.notify_all();
+    }
+  }
+}
+
+const expr::Byte *ParallelRunner::Decode(const expr::Byte *code, size_t len) {
+  m_merger.reset();
+  m_outputs.clear();
+  m_output = 0;
+  m_offset = 0;
+  const expr::Byte *p = code;
+  for (auto &worker : m_workers) {
+    worker = std::make_unique<RelRunner>();
+    p = worker->DecodeOps(code, len, true);
+    worker->Prepare();
+  }
+  const auto &ops = m_workers[0]->m_ops;
+  const auto *agg = ops.empty() ? nullptr : dynamic_cast<const op::AggOp *>(ops.back());
+  if (agg != nullptr) {
+    m_merger = std::make_unique<RelRunner>();
+    m_merger->AppendOp(agg->CreateMergeOp(&m_merger->m_pool));
+    p = m_merger->DecodeOps(p, code + len - p, false);
+    m_merger->Prepare();
+  }
+  return p;
+}
+
+void ParallelRunner::Put(const ColumnBatch *const inputs[], size_t count) {
+  if (m_output == m_outputs.size()) {
+    m_outputs.clear();
+    m_output = 0;
+    m_offset = 0;
+  }
+  size_t first = m_outputs.size();
+  if (m_merger == nullptr) {
+    m_outputs.resize(first + count);
+  }
+  size_t threads = std::min(m_workers.size(), count);
+  std::atomic<size_t> next(0);
+  std::vector<std::exception_ptr> errors(threads);
+  auto work = [&](size_t n) {
+    try {
+      Batch batch;
+      for (size_t i; (i = next.fetch_add(1)) < count;) {
+        m_workers[n]->Put(*inputs[i], m_merger != nullptr ? batch : m_outputs[first + i]);
+      }
+    } catch (...) {
+      errors[n] = std::current_exception();
+      // Stop the other workers.
+      next.store(count);
+    }
+  };
+  if (threads > 1) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (size_t n = 1; n < threads; ++n) {
+        m_tasks.emplace_back([&work, n] { work(n); });
+      }
+      m_pending += threads - 1;
+    }
+    m_queued.notify_all();
+  }
+  if (threads > 0) {
+    work(0);
+  }
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this] { return m_pending == 0; });
+  }
+  for (const auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+  if (m_merger != nullptr) {
+    Batch batch;
+    for (size_t n = 0; n < threads; ++n) {
+      for (m_workers[n]->Drain(batch, 1024); !batch.Empty(); m_workers[n]->Drain(batch, 1024)) {
+        m_merger->Put(batch);
+      }
+    }
+  }
+}
+
+void ParallelRunner::Drain(Batch &batch, size_t count) {
+  if (m_merger != nullptr) {
+    m_merger->Drain(batch, count);
+    return;
+  }
+  std::vector<const expr::Tuple *> tuples;
+  tuples.reserve(count);
+  while (tuples.size() < count && m_output < m_outputs.size()) {
+    const auto &output = m_outputs[m_output];
+    const auto &selection = output.GetSelection();
+    for (; tuples.size() < count && m_offset < selection.size(); ++m_offset) {
+      tuples.push_back(output.GetTuple(selection[m_offset]));
+    }
+    if (m_offset == selection.size()) {
+      ++m_output;
+      m_offset = 0;
+    }
+  }
+  batch.Reset(tuples.data(), tuples.size());
+}
+
+std::vector<OpStats> ParallelRunner::GetStats() const {
+  std::vector<OpStats> stats;
+  for (const auto &worker : m_workers) {
+    if (worker == nullptr) {
+      continue;
+    }
+    auto s = worker->GetStats();
+    if (stats.empty()) {
+      stats = std::move(s);
+      continue;
+    }
+    for (size_t i = 0; i < stats.size(); ++i) {
+      stats[i].rows_in += s[i].rows_in;
+      stats[i].rows_out += s[i].rows_out;
+      stats[i].nanos += s[i].nanos;
+      stats[i].groups += s[i].groups;
+      stats[i].buckets += s[i].buckets;
+      stats[i].max_probe_length = std::max(stats[i].max_probe_length, s[i].max_probe_length);
+      stats[i].peak_bytes += s[i].peak_bytes;
+    }
+  }
+  if (m_merger != nullptr) {
+    auto s = m_merger->GetStats();
+    stats.insert(stats.end(), s.begin(), s.end());
+  }
+  return stats;
+}
+
+}  // namespace dingodb::rel
@@ -0,0 +1,114 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _REL_PARALLEL_RUNNER_H_
+#define _REL_PARALLEL_RUNNER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rel_runner.h"
+
+namespace dingodb::rel {
+
+/**
+ * @brief Run the operators of a `RelRunner` on column batches in parallel.
+ *
+ * Each worker thread has its own pipeline, decoded from the same code, and the batches are the morsels claimed by the
+ * workers one at a time, so a worker finished early takes over the batches not yet started by the others. The
+ * operators up to the first aggregation run in the workers, the partial results of which are aggregated again by a
+ * merging aggregation (see `AggOp::CreateMergeOp`) followed by the rest of the operators on the calling thread.
+ *
+ * The worker threads are started once with the runner and wait for work between calls, so putting many small groups of
+ * batches, e.g. the chunks of a region scan, does not start threads each time, and the per-thread caches (e.g. the
+ * pool of decimals) are kept. The first worker runs on the calling thread.
+ */
+class ParallelRunner {
+ public:
+  /**
+   * @brief Construct a new parallel runner, and start the worker threads.
+   *
+   * @param threads number of the workers, including the calling thread, the number of hardware threads if 0
+   */
+  explicit ParallelRunner(size_t threads = 0);
+  virtual ~ParallelRunner();
+
+  const expr::Byte *Decode(const expr::Byte *code, size_t len);
+
+  /**
+   * @brief Put the column batches, which are processed by the workers in parallel. Can be called more than once before
+   * draining.
+   *
+   * @param inputs the column batches, which are borrowed
+   * @param count number of the column batches
+   */
+  void Put(const ColumnBatch *const inputs[], size_t count);
+
+  /**
+   * @brief Get output tuples in a batch after all the inputs are put. Without aggregations, the outputs are in the
+   * order of the input batches and borrowed from the runner, valid until the next `Put`; otherwise they are the same as
+   * `RelRunner::Drain`.
+   *
+   * @param batch the batch, of which no tuples are selected if there are no more outputs
+   * @param count max number of tuples to get
+   */
+  void Drain(Batch &batch, size_t count);
+
+  /**
+   * @brief Get the execution statistics of the operators, those of the workers summed up, followed by those of the
+   * merging aggregation and the operators after it.
+   *
+   * @return std::vector<OpStats> the statistics
+   */
+  std::vector<OpStats> GetStats() const;
+
+  size_t GetThreads() const {
+    return m_workers.size();
+  }
+
+ private:
+  std::vector<std::unique_ptr<RelRunner>> m_workers;
+  // The merging aggregation and the operators after it, `nullptr` if there are no aggregations.
+  std::unique_ptr<RelRunner> m_merger;
+  // Outputs of the input batches, if there are no aggregations.
+  std::vector<Batch> m_outputs;
+  // The next output to drain, and the next selected tuple in it.
+  size_t m_output;
+  size_t m_offset;
+  // Threads of the workers other than the first, taking the tasks from the queue.
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  // Signaled when tasks are queued or the threads are to stop.
+  std::condition_variable m_queued;
+  // Signaled when all the tasks queued are finished.
+  std::condition_variable m_finished;
+  std::deque<std::function<void()>> m_tasks;
+  // Number of the tasks queued or running.
+  size_t m_pending;
+  bool m_stopping;
+
+  /**
+   * @brief Run the tasks queued, until stopping.
+   */
+  void Loop();
+};
+
+}  // namespace dingodb::rel
+
+#endif /* _REL_PARALLEL_RUNNER_H_ */
@@ -14,8 +14,11 @@
 
 #include "rel_runner.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 
+#include "../expr/bitmap.h"
 #include "../expr/exception.h"
 #include "../expr/runner.h"
 #include "op/filter_op.h"
@@ -41,7 +44,8 @@ static const expr::Byte AGG_SUM = 0x20;
 static const expr::Byte AGG_MAX = 0x30;
 static const expr::Byte AGG_MIN = 0x40;
 
-RelRunner::RelRunner() : m_op(nullptr) {
+RelRunner::RelRunner()
+    : m_op(nullptr), m_all_columns(false), m_timing(false), m_probe_stats(false), m_sink(nullptr), m_filter(nullptr), m_grouped_agg(nullptr) {
 }
 
 RelRunner::~RelRunner() {
@@ -50,17 +54,30 @@ RelRunner::~RelRunner() {
 
 const expr::Byte *RelRunner::Decode(const expr::Byte *code, size_t len) {
   Release();
+  const expr::Byte *p = DecodeOps(code, len, false);
+  Prepare();
+  return p;
+}
+
+const expr::Byte *RelRunner::DecodeOps(const expr::Byte *code, size_t len, bool partial) {
   bool successful = true;
+  bool stopped = false;
   const expr::Byte *p = code;
   const expr::Byte *b;
-  while (successful && p < code + len) {
+  while (successful && !stopped && p < code + len) {
     b = p;
     switch (*p) {
     case FILTER_OP: {
       ++p;
       auto *filter = new expr::Runner();
       p = filter->Decode(p, code + len - p);
-      AppendOp(new op::FilterOp(filter));
+      auto *op = new op::FilterOp(filter, &m_pool);
+      if (m_ops.empty()) {
+        m_filter = op;
+        op->GetInputVars(m_filter_vars);
+        m_conjuncts = op->GetSelectConjuncts();
+      }
+      AppendOp(op);
       break;
     }
     case PROJECT_OP: {
@@ -79,14 +96,20 @@ const expr::Byte *RelRunner::Decode(const expr::Byte *code, size_t len) {
       p = expr::DecodeArray(groupe_indices, count, p, code + len - p);
       std::vector<const op::Agg *> *aggs;
       p = expr::DecodeVector(aggs, p, code + len - p);
-      AppendOp(new op::GroupedAggOp(groupe_indices, count, aggs));
+      auto *op = new op::GroupedAggOp(groupe_indices, count, aggs, &m_pool);
+      if (m_ops.empty() || (m_ops.size() == 1 && m_filter != nullptr)) {
+        m_grouped_agg = op;
+      }
+      AppendOp(op);
+      stopped = partial;
       break;
     }
     case UNGROUPED_AGGREGATE: {
       ++p;
       std::vector<const op::Agg *> *aggs;
       p = expr::DecodeVector(aggs, p, code + len - p);
-      AppendOp(new op::UngroupedAggOp(aggs));
+      AppendOp(new op::UngroupedAggOp(aggs, &m_pool));
+      stopped = partial;
       break;
     }
     default:
@@ -100,15 +123,205 @@ const expr::Byte *RelRunner::Decode(const expr::Byte *code, size_t len) {
   throw std::runtime_error("Unknown instruction, bytes = " + expr::HexOfBytes(b, len - (b - code)));
 }
 
+void RelRunner::Prepare() {
+  if (m_op != nullptr) {
+    m_op->GetInputVars(m_input_vars);
+    for (const auto &var : m_input_vars) {
+      m_input_indices.push_back(var.index);
+    }
+    m_all_columns = m_op->PassesThrough();
+    m_op->EnableTiming(m_timing);
+    m_op->EnableProbeStats(m_probe_stats);
+  }
+}
+
 const expr::Tuple *RelRunner::Put(const expr::Tuple *tuple) const {
-  return m_op->Put(tuple);
+  return m_op->Put(TuplePtr(const_cast<expr::Tuple *>(tuple))).release();
+}
+
+TuplePtr RelRunner::PutTuple(TuplePtr tuple) const {
+  return m_op->Put(std::move(tuple));
+}
+
+void RelRunner::Put(Batch &batch) const {
+  m_op->Put(batch);
+  Push(batch);
+}
+
+void RelRunner::Put(const ColumnBatch &columns, Batch &batch) const {
+  bool filtered = m_filter != nullptr && m_filter_vars.size() == 1 && columns.IsDictionary(m_filter_vars[0].index);
+  bool selecting = !filtered && !m_conjuncts.empty();
+  bool encoding = false;
+  if (m_grouped_agg != nullptr) {
+    for (auto i : m_input_indices) {
+      encoding = encoding || columns.IsDictionary(i);
+    }
+  }
+  if (!filtered && !selecting && !encoding) {
+    if (m_all_columns) {
+      columns.ToTuples(batch.Reset(columns.Size()));
+    } else {
+      columns.ToTuples(batch.Reset(columns.Size()), m_input_indices);
+    }
+    m_op->Put(batch);
+    Push(batch);
+    return;
+  }
+  auto &tuples = batch.Reset(columns.Size());
+  auto &selection = batch.GetSelection();
+  if (filtered) {
+    SelectByDictionary(columns, selection);
+  } else if (selecting) {
+    filtered = SelectByColumns(columns, selection);
+  }
+  std::vector<int32_t> decoded;
+  if (m_all_columns) {
+    decoded.resize(columns.GetColumnCount());
+    std::iota(decoded.begin(), decoded.end(), 0);
+  } else {
+    decoded = m_input_indices;
+  }
+  auto keys = encoding ? TranslateKeys(columns, filtered) : KeyCodes();
+  for (const auto &key : keys) {
+    decoded.erase(std::remove(decoded.begin(), decoded.end(), key.first), decoded.end());
+  }
+  columns.ToTuples(tuples, decoded, selection);
+  for (const auto &key : keys) {
+    for (auto i : selection) {
+      auto code = columns.GetCode(key.first, i);
+      tuples[i][key.first] = code < 0 ? expr::Operand(nullptr) : key.second[code];
+    }
+  }
+  for (size_t i = filtered ? 1 : 0; i < m_ops.size() && !batch.Empty(); ++i) {
+    m_ops[i]->Put(batch);
+  }
+  Push(batch);
+}
+
+void RelRunner::SelectByDictionary(const ColumnBatch &columns, Selection &selection) const {
+  auto column = m_filter_vars[0].index;
+  const auto &entries = columns.GetDictionary(column);
+  expr::Tuple tuple(columns.GetColumnCount());
+  std::vector<bool> passes(entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    tuple[column] = entries[i];
+    passes[i] = m_filter->Test(tuple);
+  }
+  tuple[column] = nullptr;
+  bool null_passes = m_filter->Test(tuple);
+  size_t count = 0;
+  for (auto i : selection) {
+    auto code = columns.GetCode(column, i);
+    if (code < 0 ? null_passes : passes[code]) {
+      selection[count++] = i;
+    }
+  }
+  m_filter->Count(selection.size(), count);
+  selection.resize(count);
+}
+
+bool RelRunner::SelectByColumns(const ColumnBatch &columns, Selection &selection) const {
+  size_t count = columns.Size();
+  std::vector<expr::Byte> bits(expr::BitmapBytes(count));
+  std::vector<expr::Byte> conjunct(bits.size());
+  for (size_t k = 0; k < m_conjuncts.size(); ++k) {
+    if (!columns.SelectColumn(m_conjuncts[k], k == 0 ? bits.data() : conjunct.data())) {
+      return false;
+    }
+    if (k > 0) {
+      expr::AndValidity(bits.data(), bits.data(), conjunct.data(), count);
+    }
+  }
+  size_t n = 0;
+  for (size_t word = 0; word * 64 < count; ++word) {
+    for (uint64_t w = expr::BitmapWord(bits.data(), word, count); w != 0; w &= w - 1) {
+      selection[n++] = static_cast<uint32_t>(word * 64 + __builtin_ctzll(w));
+    }
+  }
+  m_filter->Count(selection.size(), n);
+  selection.resize(n);
+  return true;
+}
+
+RelRunner::KeyCodes RelRunner::TranslateKeys(const ColumnBatch &columns, bool filtered) const {
+  KeyCodes keys;
+  for (auto column : m_input_indices) {
+    if (!columns.IsDictionary(column)) {
+      continue;
+    }
+    // The strings are still required by a filter evaluated on the tuples.
+    if (!filtered && m_filter != nullptr &&
+        std::any_of(m_filter_vars.begin(), m_filter_vars.end(), [column](const expr::VarInfo &var) {
+          return var.index == column;
+        })) {
+      continue;
+    }
+    auto *dictionary = m_grouped_agg->EncodeKey(column);
+    if (dictionary == nullptr) {
+      continue;
+    }
+    const auto &entries = columns.GetDictionary(column);
+    std::vector<expr::Operand> codes;
+    codes.reserve(entries.size());
+    for (const auto &entry : entries) {
+      if (entry == nullptr) {
+        codes.emplace_back(nullptr);
+      } else {
+        codes.emplace_back(dictionary->Encode(entry.GetValue<expr::String>()));
+      }
+    }
+    keys.emplace_back(column, std::move(codes));
+  }
+  return keys;
 }
 
 const expr::Tuple *RelRunner::Get() const {
+  return m_op->Get().release();
+}
+
+TuplePtr RelRunner::GetTuple() const {
   return m_op->Get();
 }
 
+void RelRunner::Drain(Batch &batch, size_t count) const {
+  m_op->Drain(batch, count);
+}
+
+void RelRunner::Finish(size_t count) const {
+  if (m_sink == nullptr) {
+    return;
+  }
+  Batch batch;
+  for (Drain(batch, count); !batch.Empty(); Drain(batch, count)) {
+    m_sink->Consume(batch);
+  }
+  m_sink->Finish();
+}
+
+std::vector<OpStats> RelRunner::GetStats() const {
+  std::vector<OpStats> stats;
+  if (m_op != nullptr) {
+    m_op->GetStats(stats);
+  }
+  return stats;
+}
+
+void RelRunner::EnableTiming(bool enabled) {
+  m_timing = enabled;
+  if (m_op != nullptr) {
+    m_op->EnableTiming(enabled);
+  }
+}
+
+void RelRunner::EnableProbeStats(bool enabled) {
+  m_probe_stats = enabled;
+  if (m_op != nullptr) {
+    m_op->EnableProbeStats(enabled);
+  }
+}
+
 void RelRunner::AppendOp(RelOp *op) {
+  m_ops.push_back(op);
   if (m_op != nullptr) {
     m_op = new op::TandemOp(m_op, op);
   } else {
@@ -175,7 +388,7 @@ const Byte *DecodeValue<const rel::op::Agg *>(const rel::op::Agg *&value, const
     p = DecodeAgg<rel::op::SumAgg<double>>(value, p);
     break;
   case rel::AGG_SUM | TYPE_DECIMAL:
-    p = DecodeAgg<rel::op::SumAgg<dingodb::types::DecimalP>>(value, p);
+    p = DecodeAgg<rel::op::DecimalSumAgg>(value, p);
     break;
   case rel::AGG_MAX | TYPE_INT32:
     p = DecodeAgg<rel::op::MaxAgg<int32_t>>(value, p);
@@ -15,13 +15,23 @@
 #ifndef _REL_REL_RUNNER_H_
 #define _REL_REL_RUNNER_H_
 
+#include <utility>
+#include <vector>
+
 #include "../expr/codec.h"
 #include "../expr/types.h"
+#include "column_batch.h"
 #include "op/agg.h"
+#include "op/filter_op.h"
+#include "op/grouped_agg_op.h"
 #include "op/rel_op.h"
+#include "sink.h"
+#include "tuple_pool.h"
 
 namespace dingodb::rel {
 
+class ParallelRunner;
+
 class RelRunner {
  public:
   RelRunner();
@@ -33,15 +43,220 @@ class RelRunner {
 
   const expr::Tuple *Get() const;
 
+  /**
+   * @brief Put a tuple, which is moved into the runner, so the values can be moved through the operators.
+   *
+   * @param tuple the tuple
+   * @return TuplePtr the output tuple, or `nullptr` if there is none
+   */
+  TuplePtr PutTuple(TuplePtr tuple) const;
+
+  /**
+   * @brief Get an output tuple after all the tuples are put.
+   *
+   * @return TuplePtr the output tuple, or `nullptr` if there is none
+   */
+  TuplePtr GetTuple() const;
+
+  /**
+   * @brief Get output tuples in a batch after all the tuples are put, which is much faster than `Get` for a lot of
+   * groups. The tuples are owned by the batch and valid until the next use of the batch.
+   *
+   * @param batch the batch, of which no tuples are selected if there are no more outputs
+   * @param count max number of tuples to get
+   */
+  void Drain(Batch &batch, size_t count) const;
+
+  /**
+   * @brief Get the execution statistics of the operators, in the order of the pipeline. They are kept after the
+   * outputs are drained.
+   *
+   * @return std::vector<OpStats> the statistics
+   */
+  std::vector<OpStats> GetStats() const;
+
+  /**
+   * @brief Enable or disable timing of the operators, which is disabled by default. The setting is kept for later
+   * `Decode`.
+   *
+   * @param enabled true to enable
+   */
+  void EnableTiming(bool enabled = true);
+
+  /**
+   * @brief Enable or disable collecting the probe lengths of hash tables, which is disabled by default. The lengths
+   * are collected by walking all the buckets of a table before it is drained. The setting is kept for later `Decode`.
+   *
+   * @param enabled true to enable
+   */
+  void EnableProbeStats(bool enabled = true);
+
+  /**
+   * @brief Get an empty tuple from the pool of the runner, to be filled and put in.
+   *
+   * @return expr::Tuple* the tuple
+   */
+  expr::Tuple *AcquireTuple() const {
+    return m_pool.Acquire();
+  }
+
+  /**
+   * @brief Return an output tuple to the pool of the runner, instead of deleting it.
+   *
+   * @param tuple the tuple
+   */
+  void ReleaseTuple(const expr::Tuple *tuple) const {
+    m_pool.Release(tuple);
+  }
+
+  /**
+   * @brief Put a batch of tuples, which are borrowed, i.e. not moved or released. Filtering only narrows the
+   * selection vector of the batch.
+   *
+   * On return, the selected tuples of the batch are the output, which are valid until the next use of the batch.
+   *
+   * @param batch the batch
+   */
+  void Put(Batch &batch) const;
+
+  /**
+   * @brief Put a batch of columns. The rows are converted into tuples owned by `batch`, and then processed as `Put`
+   * with a batch of tuples.
+   *
+   * Dictionary-encoded columns are not decoded row by row where possible: a leading filter reading only such a column
+   * is evaluated once per entry of the dictionary, and a grouping key of such a column is grouped on the codes. A
+   * leading filter of comparisons of fixed-width columns with constants, joined by ANDs, is evaluated over the columns
+   * into bitmaps (see `expr::calc::SelectBatch`), and only the rows passed are converted.
+   *
+   * @param columns the columns
+   * @param batch the batch for the tuples and the output
+   */
+  void Put(const ColumnBatch &columns, Batch &batch) const;
+
+  /**
+   * @brief Set the sink to which the outputs are pushed. With a sink, the outputs of putting a batch, if any, are also
+   * consumed by the sink before `Put` returns, and the outputs of aggregations are pushed by `Finish`. Putting tuples
+   * one by one is not affected. The setting is kept for later `Decode`.
+   *
+   * @param sink the sink, which is borrowed, or `nullptr` to disable pushing
+   */
+  void SetSink(Sink *sink) {
+    m_sink = sink;
+  }
+
+  /**
+   * @brief Push the remaining outputs to the sink in batches after all the inputs are put, and then finish the sink.
+   * Does nothing if there is no sink.
+   *
+   * @param count max number of tuples in a batch
+   */
+  void Finish(size_t count = 1024) const;
+
+  /**
+   * @brief Get the variables of the input tuples read by the operators, in the order of first use. The type of a
+   * variable is `TYPE_NULL` if it is not determined by the operators, e.g. for grouping keys.
+   *
+   * @return const std::vector<expr::VarInfo>& the variables
+   */
+  const std::vector<expr::VarInfo> &GetInputVars() const {
+    return m_input_vars;
+  }
+
  private:
+  friend class ParallelRunner;
+
+  // Tuples released by the operators, freed along with the runner.
+  mutable TuplePool m_pool;
   RelOp *m_op;
+  std::vector<expr::VarInfo> m_input_vars;
+  // Indices of `m_input_vars`, which are the only columns decoded from a column batch.
+  std::vector<int32_t> m_input_indices;
+  // All the columns are required if the input tuples are output as is.
+  bool m_all_columns;
+  bool m_timing;
+  bool m_probe_stats;
+  Sink *m_sink;
+  // The operators in the order of the pipeline, owned by `m_op`.
+  std::vector<RelOp *> m_ops;
+  // The leading filter and the variables it reads, evaluated on dictionaries if it reads a single column.
+  const op::FilterOp *m_filter;
+  std::vector<expr::VarInfo> m_filter_vars;
+  // The comparisons of the leading filter, if it can be evaluated over columns.
+  std::vector<const expr::Operator *> m_conjuncts;
+  // The aggregation reading the input columns, i.e. the first operator or the one after the leading filter.
+  op::GroupedAggOp *m_grouped_agg;
 
   void Release() {
     delete m_op;
     m_op = nullptr;
+    m_ops.clear();
+    m_filter = nullptr;
+    m_filter_vars.clear();
+    m_conjuncts.clear();
+    m_grouped_agg = nullptr;
+    m_input_vars.clear();
+    m_input_indices.clear();
+    m_all_columns = false;
+    m_pool.Clear();
   }
 
   void AppendOp(RelOp *op);
+
+  /**
+   * @brief Push the outputs in a batch to the sink, if there are any and there is a sink.
+   */
+  void Push(const Batch &batch) const {
+    if (m_sink != nullptr && !batch.Empty()) {
+      m_sink->Consume(batch);
+    }
+  }
+
+  /**
+   * @brief Decode the operators and append them to the pipeline.
+   *
+   * @param code the code
+   * @param len length of the code
+   * @param partial whether to stop after the first aggregation, so the rest can be run on its merged outputs
+   * @return const expr::Byte* the position after the decoded operators
+   */
+  const expr::Byte *DecodeOps(const expr::Byte *code, size_t len, bool partial);
+
+  /**
+   * @brief Collect the input variables of the pipeline after the operators are appended.
+   */
+  void Prepare();
+
+  /**
+   * @brief Select the rows of a column batch passing the leading filter, which is evaluated once per entry of the
+   * dictionary of the column it reads.
+   *
+   * @param columns the columns
+   * @param selection the selection, all rows selected on input
+   */
+  void SelectByDictionary(const ColumnBatch &columns, Selection &selection) const;
+
+  /**
+   * @brief Select the rows of a column batch passing the leading filter, which is evaluated over the columns by
+   * ANDing the bitmaps of the comparisons.
+   *
+   * @param columns the columns
+   * @param selection the selection, all rows selected on input
+   * @return true if the filter is evaluated, false if some column cannot be read in place and nothing is changed
+   */
+  bool SelectByColumns(const ColumnBatch &columns, Selection &selection) const;
+
+  // Grouping key columns with the stable codes of the entries of their dictionaries in a column batch.
+  using KeyCodes = std::vector<std::pair<int32_t, std::vector<expr::Operand>>>;
+
+  /**
+   * @brief Translate the dictionaries of the grouping keys of a column batch into the stable codes of the aggregation,
+   * once per entry.
+   *
+   * @param columns the columns
+   * @param filtered whether the leading filter has been evaluated on the dictionary
+   * @return KeyCodes the key columns grouped on codes, and the codes of the entries
+   */
+  KeyCodes TranslateKeys(const ColumnBatch &columns, bool filtered) const;
 };
 
 }  // namespace dingodb::rel
@@ -0,0 +1,69 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _REL_SINK_H_
+#define _REL_SINK_H_
+
+#include <functional>
+#include <utility>
+
+#include "batch.h"
+
+namespace dingodb::rel {
+
+/**
+ * @brief A consumer of the outputs of a `RelRunner`, to which the output batches are pushed as soon as they are
+ * produced, instead of being polled by the caller.
+ */
+class Sink {
+ public:
+  Sink() = default;
+  virtual ~Sink() = default;
+
+  /**
+   * @brief Consume a batch of outputs, which is not empty. The selected tuples are the outputs, valid only during the
+   * call, so they must be copied or encoded before returning.
+   *
+   * @param batch the batch
+   */
+  virtual void Consume(const Batch &batch) = 0;
+
+  /**
+   * @brief Called once after all the outputs are consumed.
+   */
+  virtual void Finish() {
+  }
+};
+
+/**
+ * @brief A sink calling a function for each batch.
+ */
+class CallbackSink : public Sink {
+ public:
+  explicit CallbackSink(std::function<void(const Batch &)> callback) : m_callback(std::move(callback)) {
+  }
+
+  ~CallbackSink() override = default;
+
+  void Consume(const Batch &batch) override {
+    m_callback(batch);
+  }
+
+ private:
+  std::function<void(const Batch &)> m_callback;
+};
+
+}  // namespace dingodb::rel
+
+#endif /* _REL_SINK_H_ */
@@ -0,0 +1,100 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _REL_TUPLE_POOL_H_
+#define _REL_TUPLE_POOL_H_
+
+#include <vector>
+
+#include "../expr/operand.h"
+
+namespace dingodb::rel {
+
+/**
+ * @brief A pool of tuples, to reuse the tuples (and their storage) released by the operators.
+ *
+ * This is a capped free list rather than a per-query arena. The tuples output by `RelRunner::Get` and `GetTuple` are
+ * owned by the caller, who may free them by `delete` (or `TuplePtr`) at any time, also after the runner is destroyed,
+ * so each tuple must be a heap object of its own. That rules out carving tuples from arena blocks freed in one step.
+ * The allocations saved are the same in steady state, because a released tuple and its storage are reused by the next
+ * acquire instead of going to the heap. Only the tuples cached when the pool is cleared are freed one by one.
+ */
+class TuplePool {
+ public:
+  static const size_t DEFAULT_CAPACITY = 1024;
+
+  TuplePool(size_t capacity = DEFAULT_CAPACITY) : m_capacity(capacity) {
+  }
+
+  virtual ~TuplePool() {
+    Clear();
+  }
+
+  TuplePool(const TuplePool &) = delete;
+  TuplePool &operator=(const TuplePool &) = delete;
+
+  /**
+   * @brief Get an empty tuple.
+   *
+   * @return expr::Tuple* the tuple
+   */
+  expr::Tuple *Acquire() {
+    if (!m_free.empty()) {
+      auto *tuple = m_free.back();
+      m_free.pop_back();
+      return tuple;
+    }
+    return new expr::Tuple();
+  }
+
+  /**
+   * @brief Return a tuple to the pool. The values are released but the storage is kept for reusing, unless the pool
+   * is full.
+   *
+   * @param tuple the tuple
+   */
+  void Release(const expr::Tuple *tuple) {
+    if (tuple == nullptr) {
+      return;
+    }
+    auto *t = const_cast<expr::Tuple *>(tuple);
+    if (m_free.size() < m_capacity) {
+      t->clear();
+      m_free.push_back(t);
+    } else {
+      delete t;
+    }
+  }
+
+  /**
+   * @brief Free all the cached tuples.
+   */
+  void Clear() {
+    for (auto *tuple : m_free) {
+      delete tuple;
+    }
+    m_free.clear();
+  }
+
+  size_t Size() const {
+    return m_free.size();
+  }
+
+ private:
+  size_t m_capacity;
+  std::vector<expr::Tuple *> m_free;
+};
+
+}  // namespace dingodb::rel
+
+#endif /* _REL_TUPLE_POOL_H_ */
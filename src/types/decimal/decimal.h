@@ -368,9 +368,21 @@ class Decimal {
       scale = v;
     }
 
+  /**
+   * Get the significant digits in base 10, i.e. the value is 0.d1d2...dn * 10^exp.
+   * @param exp The exponent.
+   * @return The digits, with a leading '-' if negative, empty for 0.
+   */
+  std::string getDigits(mp_exp_t &exp) const {
+    return v.get_str(exp);
+  }
+
  private:
-  long precision;
-  long scale;
+  /**
+   * 0 if not specified, then the value is cast to string as it is.
+   */
+  long precision = 0;
+  long scale = 0;
   mpf_class v;
 
   /**
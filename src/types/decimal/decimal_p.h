@@ -17,8 +17,10 @@
 
 #include <cmath>
 #include <memory>
+#include <utility>
 
 #include "decimal.h"
+#include "decimal_pool.h"
 
 namespace dingodb {
 namespace types {
@@ -30,19 +32,22 @@ class DecimalP {
   DecimalP(const std::shared_ptr<Decimal> &ptr) : m_ptr(ptr) {
   }
 
-  DecimalP(const Decimal &dec) : m_ptr(std::make_shared<Decimal>(dec)) {
+  DecimalP(const Decimal &dec) : m_ptr(Make(dec)) {
   }
 
-  DecimalP(const long var) : m_ptr(std::make_shared<Decimal>(var)){
+  DecimalP(Decimal &&dec) : m_ptr(Make(std::move(dec))) {
   }
 
-  DecimalP(const double var) : m_ptr(std::make_shared<Decimal>(var)) {
+  DecimalP(const long var) : m_ptr(Make(var)){
   }
 
-  DecimalP(const std::string& str) : m_ptr(std::make_shared<Decimal>(str)) {
+  DecimalP(const double var) : m_ptr(Make(var)) {
   }
 
-  DecimalP() : m_ptr(std::make_shared<Decimal>()) {
+  DecimalP(const std::string& str) : m_ptr(Make(str)) {
+  }
+
+  DecimalP() : m_ptr(Make()) {
   }
 
   ValueType GetPtr() const {
@@ -144,6 +149,14 @@ class DecimalP {
  private:
   ValueType m_ptr;
 
+  /**
+   * The object and the control block are allocated together from the pool of decimals (see "decimal_pool.h").
+   */
+  template <typename... Args>
+  static ValueType Make(Args &&...args) {
+    return std::allocate_shared<Decimal>(DecimalPoolAllocator<Decimal>(), std::forward<Args>(args)...);
+  }
+
   friend class Operand;
 
   friend std::ostream &operator<<(std::ostream &os, const DecimalP &v);
@@ -0,0 +1,198 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "decimal_pool.h"
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "gmp.h"
+
+namespace dingodb {
+namespace types {
+
+namespace {
+
+struct MemoryFunctions {
+  void *(*allocate)(size_t);
+  void *(*reallocate)(void *, size_t, size_t);
+  void (*free)(void *, size_t);
+};
+
+void *ObjectAllocate(size_t size) {
+  return ::operator new(size);
+}
+
+void ObjectFree(void *ptr, size_t /*size*/) {
+  ::operator delete(ptr);
+}
+
+// The blocks of the objects held by `DecimalP` are got from the global heap, whatever the memory functions of GMP are.
+const MemoryFunctions OBJECT_FUNCTIONS = {ObjectAllocate, nullptr, ObjectFree};
+
+// The memory functions of GMP replaced by `InstallDecimalPool`, from which the blocks of limbs are got.
+MemoryFunctions g_gmp_previous = {nullptr, nullptr, nullptr};
+
+bool IsPoolable(size_t size) {
+  return size != 0 && size <= DECIMAL_POOL_MAX_BLOCK && size % 8 == 0;
+}
+
+/**
+ * Blocks cached by a thread, all got from and finally freed to the same memory functions.
+ */
+class ThreadCache {
+ public:
+  enum Kind { OBJECTS, LIMBS };
+
+  explicit ThreadCache(const MemoryFunctions &functions) : m_functions(functions), m_stats{0, 0, 0} {
+  }
+
+  ~ThreadCache() {
+    s_destroyed = true;
+    for (size_t i = 0; i < CLASS_NUM; ++i) {
+      for (auto *block : m_blocks[i]) {
+        m_functions.free(block, (i + 1) * 8);
+      }
+    }
+  }
+
+  static ThreadCache *Get(Kind kind) {
+    // Blocks freed by static objects destroyed after the caches go to the memory functions directly.
+    if (s_destroyed) {
+      return nullptr;
+    }
+    if (kind == OBJECTS) {
+      static thread_local ThreadCache objects(OBJECT_FUNCTIONS);
+      return &objects;
+    }
+    static thread_local ThreadCache limbs(g_gmp_previous);
+    return &limbs;
+  }
+
+  void *Allocate(size_t size) {
+    auto &blocks = m_blocks[size / 8 - 1];
+    if (!blocks.empty()) {
+      void *block = blocks.back();
+      blocks.pop_back();
+      ++m_stats.hits;
+      --m_stats.cached;
+      return block;
+    }
+    ++m_stats.misses;
+    return m_functions.allocate(size);
+  }
+
+  void Free(void *ptr, size_t size) {
+    auto &blocks = m_blocks[size / 8 - 1];
+    if (blocks.size() < DECIMAL_POOL_MAX_CACHED) {
+      blocks.push_back(ptr);
+      ++m_stats.cached;
+      return;
+    }
+    m_functions.free(ptr, size);
+  }
+
+  const DecimalPoolStats &GetStats() const {
+    return m_stats;
+  }
+
+ private:
+  static const size_t CLASS_NUM = DECIMAL_POOL_MAX_BLOCK / 8;
+
+  static thread_local bool s_destroyed;
+
+  const MemoryFunctions &m_functions;
+  std::vector<void *> m_blocks[CLASS_NUM];
+  DecimalPoolStats m_stats;
+};
+
+thread_local bool ThreadCache::s_destroyed = false;
+
+void *Allocate(ThreadCache::Kind kind, const MemoryFunctions &functions, size_t size) {
+  ThreadCache *cache;
+  if (IsPoolable(size) && (cache = ThreadCache::Get(kind)) != nullptr) {
+    return cache->Allocate(size);
+  }
+  return functions.allocate(size);
+}
+
+void Free(ThreadCache::Kind kind, const MemoryFunctions &functions, void *ptr, size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+  ThreadCache *cache;
+  if (IsPoolable(size) && (cache = ThreadCache::Get(kind)) != nullptr) {
+    cache->Free(ptr, size);
+    return;
+  }
+  functions.free(ptr, size);
+}
+
+void *PoolAllocate(size_t size) {
+  return Allocate(ThreadCache::LIMBS, g_gmp_previous, size);
+}
+
+void PoolFree(void *ptr, size_t size) {
+  Free(ThreadCache::LIMBS, g_gmp_previous, ptr, size);
+}
+
+void *PoolReallocate(void *ptr, size_t old_size, size_t new_size) {
+  if (!IsPoolable(old_size) && !IsPoolable(new_size)) {
+    return g_gmp_previous.reallocate(ptr, old_size, new_size);
+  }
+  if (old_size == new_size) {
+    return ptr;
+  }
+  void *block = PoolAllocate(new_size);
+  memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+  PoolFree(ptr, old_size);
+  return block;
+}
+
+}  // namespace
+
+void InstallDecimalPool() {
+  static const bool installed = [] {
+    // The functions in effect now, which may have been set by the host after any decimal was created.
+    mp_get_memory_functions(&g_gmp_previous.allocate, &g_gmp_previous.reallocate, &g_gmp_previous.free);
+    mp_set_memory_functions(PoolAllocate, PoolReallocate, PoolFree);
+    return true;
+  }();
+  (void)installed;
+}
+
+void *DecimalPoolAllocate(size_t size) {
+  return Allocate(ThreadCache::OBJECTS, OBJECT_FUNCTIONS, size);
+}
+
+void DecimalPoolFree(void *ptr, size_t size) {
+  Free(ThreadCache::OBJECTS, OBJECT_FUNCTIONS, ptr, size);
+}
+
+DecimalPoolStats GetDecimalPoolStats() {
+  DecimalPoolStats stats{0, 0, 0};
+  for (auto kind : {ThreadCache::OBJECTS, ThreadCache::LIMBS}) {
+    auto *cache = ThreadCache::Get(kind);
+    if (cache != nullptr) {
+      stats.hits += cache->GetStats().hits;
+      stats.misses += cache->GetStats().misses;
+      stats.cached += cache->GetStats().cached;
+    }
+  }
+  return stats;
+}
+
+}  // namespace types
+}  // namespace dingodb
@@ -0,0 +1,113 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGO_LIBEXPR_DECIMAL_POOL_H
+#define DINGO_LIBEXPR_DECIMAL_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dingodb {
+namespace types {
+
+/**
+ * Per-thread pool of the small memory blocks of decimals, i.e. the objects held by `DecimalP`, and also the limbs of
+ * `mpf_class` values if installed into GMP by `InstallDecimalPool`, so the temporaries of decimal arithmetic are
+ * recycled instead of going to the global heap.
+ *
+ * Blocks are cached by their exact sizes (multiples of 8 bytes, up to `DECIMAL_POOL_MAX_BLOCK`), and may be freed by
+ * any thread. The blocks of the objects are got from the global heap, and those of the limbs from the memory functions
+ * of GMP in effect when the pool is installed, so they are interchangeable with the blocks GMP allocated before. Other
+ * sizes go to these functions directly.
+ */
+const size_t DECIMAL_POOL_MAX_BLOCK = 512;
+
+/**
+ * Max number of cached blocks of each size per thread.
+ */
+const size_t DECIMAL_POOL_MAX_CACHED = 256;
+
+/**
+ * Statistics of the pool of a thread, of both the objects and the limbs.
+ */
+struct DecimalPoolStats {
+  // Allocations served by cached blocks.
+  uint64_t hits;
+  // Allocations of poolable sizes that went to the previous memory functions.
+  uint64_t misses;
+  // Blocks cached currently.
+  uint64_t cached;
+};
+
+/**
+ * Install the pool as the memory functions of GMP, which is not done unless called, for they are global to the process
+ * and shared with any other user of GMP in it. The functions replaced are got at the first call, so a host setting its
+ * own functions must do so before. Installing more than once has no effect.
+ *
+ * A block is cached by the size passed to the free function, so every user of GMP in the process must free a block
+ * with the size it was allocated with, as GMP itself does.
+ */
+void InstallDecimalPool();
+
+void *DecimalPoolAllocate(size_t size);
+
+void DecimalPoolFree(void *ptr, size_t size);
+
+/**
+ * Get the statistics of the pool of the current thread.
+ */
+DecimalPoolStats GetDecimalPoolStats();
+
+/**
+ * Allocator drawing from the pool, for `std::allocate_shared`.
+ */
+template <typename T>
+class DecimalPoolAllocator {
+ public:
+  using value_type = T;
+
+  DecimalPoolAllocator() = default;
+
+  template <typename U>
+  DecimalPoolAllocator(const DecimalPoolAllocator<U> &) {
+  }
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(DecimalPoolAllocate(RoundedSize(n)));
+  }
+
+  void deallocate(T *p, size_t n) {
+    DecimalPoolFree(p, RoundedSize(n));
+  }
+
+  template <typename U>
+  bool operator==(const DecimalPoolAllocator<U> &) const {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const DecimalPoolAllocator<U> &) const {
+    return false;
+  }
+
+ private:
+  static size_t RoundedSize(size_t n) {
+    return (n * sizeof(T) + 7) & ~static_cast<size_t>(7);
+  }
+};
+
+}  // namespace types
+}  // namespace dingodb
+
+#endif  // DINGO_LIBEXPR_DECIMAL_POOL_H
@@ -0,0 +1,250 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "arithmetic.h"
+#include "batch.h"
+#include "exception.h"
+#include "select.h"
+
+using namespace dingodb::expr;
+
+static std::vector<Byte> MakeValidity(size_t count, size_t null_step) {
+  std::vector<Byte> validity(BitmapBytes(count));
+  BitmapFill(validity.data(), count, true);
+  for (size_t i = 0; i < count; i += null_step) {
+    BitmapClear(validity.data(), i);
+  }
+  return validity;
+}
+
+TEST(TestBitmap, AndValidity) {
+  const size_t count = 150;
+  auto v0 = MakeValidity(count, 2);
+  auto v1 = MakeValidity(count, 3);
+  std::vector<Byte> buf(BitmapBytes(count));
+  EXPECT_EQ(AndValidity(buf.data(), nullptr, nullptr, count), nullptr);
+  EXPECT_EQ(AndValidity(buf.data(), v0.data(), nullptr, count), v0.data());
+  EXPECT_EQ(AndValidity(buf.data(), nullptr, v1.data(), count), v1.data());
+  const auto *v = AndValidity(buf.data(), v0.data(), v1.data(), count);
+  ASSERT_EQ(v, buf.data());
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(BitmapGet(v, i), i % 2 != 0 && i % 3 != 0);
+  }
+  uint64_t word = 0;
+  for (size_t i = 128; i < count; ++i) {
+    word |= (uint64_t)BitmapGet(v, i) << (i - 128);
+  }
+  EXPECT_EQ(BitmapWord(v, 2, count), word);
+}
+
+TEST(TestBatch, Binary) {
+  const size_t count = 200;
+  std::vector<int64_t> in0(count), in1(count), out(count);
+  for (size_t i = 0; i < count; ++i) {
+    in0[i] = i;
+    in1[i] = 2 * i;
+  }
+  auto v0 = MakeValidity(count, 3);
+  // Never read at null slots, or it overflows.
+  for (size_t i = 0; i < count; i += 3) {
+    in0[i] = std::numeric_limits<int64_t>::max();
+  }
+  std::vector<Byte> validity(BitmapBytes(count));
+  const auto *v = calc::BinaryBatch<TYPE_INT64, TYPE_INT64, TYPE_INT64, calc::Add>(
+      out.data(), validity.data(), in0.data(), v0.data(), in1.data(), nullptr, count);
+  EXPECT_EQ(v, v0.data());
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(out[i], i % 3 == 0 ? 0 : 3 * i);
+  }
+  auto v1 = MakeValidity(count, 5);
+  v = calc::BinaryBatch<TYPE_INT64, TYPE_INT64, TYPE_INT64, calc::Add>(
+      out.data(), validity.data(), in0.data(), v0.data(), in1.data(), v1.data(), count);
+  EXPECT_EQ(v, validity.data());
+  for (size_t i = 0; i < count; ++i) {
+    bool valid = i % 3 != 0 && i % 5 != 0;
+    EXPECT_EQ(BitmapGet(v, i), valid);
+    EXPECT_EQ(out[i], valid ? 3 * i : 0);
+  }
+}
+
+static int32_t MulAdd(int32_t x, int32_t y, int32_t z) {
+  return x + y * z;
+}
+
+TEST(TestBatch, UnaryAndTertiary) {
+  const size_t count = 70;
+  std::vector<double> in(count), out(count);
+  for (size_t i = 0; i < count; ++i) {
+    in[i] = i * 0.5;
+  }
+  EXPECT_EQ((calc::UnaryBatch<TYPE_DOUBLE, TYPE_DOUBLE, calc::Neg>(out.data(), in.data(), nullptr, count)), nullptr);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(out[i], -0.5 * i);
+  }
+  std::vector<int32_t> a(count, 1), b(count, 2), c(count, 3), r(count);
+  auto va = MakeValidity(count, 7);
+  auto vc = MakeValidity(count, 11);
+  std::vector<Byte> validity(BitmapBytes(count));
+  const auto *v = calc::TertiaryBatch<TYPE_INT32, TYPE_INT32, TYPE_INT32, TYPE_INT32, MulAdd>(
+      r.data(), validity.data(), a.data(), va.data(), b.data(), nullptr, c.data(), vc.data(), count);
+  for (size_t i = 0; i < count; ++i) {
+    bool valid = i % 7 != 0 && i % 11 != 0;
+    EXPECT_EQ(BitmapGet(v, i), valid);
+    EXPECT_EQ(r[i], valid ? 7 : 0);
+  }
+}
+
+TEST(TestBatch, OverflowPrimitives) {
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const int64_t min = std::numeric_limits<int64_t>::min();
+  int64_t r;
+  EXPECT_GE(calc::AddOverflow<int64_t>(max - 1, 1, &r), 0);
+  EXPECT_EQ(r, max);
+  EXPECT_LT(calc::AddOverflow<int64_t>(max, 1, &r), 0);
+  EXPECT_LT(calc::AddOverflow<int64_t>(min, -1, &r), 0);
+  EXPECT_GE(calc::SubOverflow<int64_t>(min + 1, 1, &r), 0);
+  EXPECT_EQ(r, min);
+  EXPECT_LT(calc::SubOverflow<int64_t>(min, 1, &r), 0);
+  EXPECT_LT(calc::SubOverflow<int64_t>(0, min, &r), 0);
+  EXPECT_GE(calc::MulOverflow<int64_t>(-1, max, &r), 0);
+  EXPECT_EQ(r, -max);
+  EXPECT_LT(calc::MulOverflow<int64_t>(-1, min, &r), 0);
+  int32_t s;
+  EXPECT_LT(calc::AddOverflow<int32_t>(std::numeric_limits<int32_t>::max(), 1, &s), 0);
+  EXPECT_GE(calc::SubOverflow<int32_t>(-1, std::numeric_limits<int32_t>::min(), &s), 0);
+  EXPECT_EQ(s, std::numeric_limits<int32_t>::max());
+  EXPECT_THROW(calc::Add<long>(max, 1), ExceedsLimits<TYPE_INT64>);
+}
+
+TEST(TestBatch, CheckedBinary) {
+  const size_t count = 200;
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  std::vector<int64_t> in0(count), in1(count, 1), out(count);
+  for (size_t i = 0; i < count; ++i) {
+    in0[i] = i;
+  }
+  std::vector<Byte> validity(BitmapBytes(count));
+  const Byte *v;
+  EXPECT_EQ((calc::CheckedBinaryBatch<TYPE_INT64, calc::AddOverflow>(
+                out.data(), validity.data(), &v, in0.data(), nullptr, in1.data(), nullptr, count)),
+            count);
+  EXPECT_EQ(v, nullptr);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(out[i], i + 1);
+  }
+  // Overflows at null slots are ignored.
+  auto v0 = MakeValidity(count, 3);
+  for (size_t i = 0; i < count; i += 3) {
+    in0[i] = max;
+  }
+  EXPECT_EQ((calc::CheckedBinaryBatch<TYPE_INT64, calc::AddOverflow>(
+                out.data(), validity.data(), &v, in0.data(), v0.data(), in1.data(), nullptr, count)),
+            count);
+  EXPECT_EQ(v, v0.data());
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(out[i], i % 3 == 0 ? 0 : i + 1);
+  }
+  // The first overflowed row is reported, in a word of all valid rows or not.
+  in0[131] = max;
+  in0[170] = max;
+  EXPECT_EQ((calc::CheckedBinaryBatch<TYPE_INT64, calc::AddOverflow>(
+                out.data(), validity.data(), &v, in0.data(), nullptr, in1.data(), nullptr, count)),
+            0);
+  EXPECT_EQ((calc::CheckedBinaryBatch<TYPE_INT64, calc::AddOverflow>(
+                out.data(), validity.data(), &v, in0.data(), v0.data(), in1.data(), nullptr, count)),
+            131);
+  for (size_t i = 0; i < 131; ++i) {
+    EXPECT_EQ(out[i], i % 3 == 0 ? 0 : i + 1);
+  }
+  std::vector<int32_t> a(count, 1 << 16), b(count, 1 << 14), c(count);
+  b[99] = 1 << 15;
+  EXPECT_EQ((calc::CheckedBinaryBatch<TYPE_INT32, calc::MulOverflow>(
+                c.data(), validity.data(), &v, a.data(), nullptr, b.data(), nullptr, count)),
+            99);
+}
+
+template <typename T>
+static bool Compare(calc::CompareOp op, T v0, T v1) {
+  switch (op) {
+  case calc::CMP_EQ:
+    return v0 == v1;
+  case calc::CMP_NE:
+    return v0 != v1;
+  case calc::CMP_LT:
+    return v0 < v1;
+  case calc::CMP_LE:
+    return v0 <= v1;
+  case calc::CMP_GT:
+    return v0 > v1;
+  default:
+    return v0 >= v1;
+  }
+}
+
+// Every kernel supported gives the same as the scalar comparison, including the tails of any length.
+template <typename T>
+static void CheckSelect(const std::vector<T> &in, T value) {
+  auto best = calc::GetSimdLevel();
+  for (int level = calc::SIMD_NONE; level <= best; ++level) {
+    calc::LimitSimdLevel((calc::SimdLevel)level);
+    for (int op = calc::CMP_EQ; op < calc::CMP_NONE; ++op) {
+      for (size_t count : {0, 1, 7, 63, 64, 65, 130}) {
+        std::vector<Byte> bits(BitmapBytes(count) + 1, 0xA5);
+        calc::SelectBatch(bits.data(), (calc::CompareOp)op, in.data(), value, count);
+        for (size_t i = 0; i < count; ++i) {
+          EXPECT_EQ(BitmapGet(bits.data(), i), Compare((calc::CompareOp)op, in[i], value))
+              << "level = " << level << ", op = " << op << ", i = " << i;
+        }
+        EXPECT_EQ(bits[BitmapBytes(count)], 0xA5);
+      }
+    }
+  }
+  calc::LimitSimdLevel(best);
+}
+
+TEST(TestSelect, SwapCompareOp) {
+  EXPECT_EQ(calc::SwapCompareOp(calc::CMP_LT), calc::CMP_GT);
+  EXPECT_EQ(calc::SwapCompareOp(calc::CMP_GE), calc::CMP_LE);
+  EXPECT_EQ(calc::SwapCompareOp(calc::CMP_NE), calc::CMP_NE);
+  EXPECT_EQ(calc::SwapCompareOp(calc::CMP_EQ), calc::CMP_EQ);
+}
+
+TEST(TestSelect, Kernels) {
+  const size_t count = 130;
+  std::vector<int32_t> i32(count);
+  std::vector<int64_t> i64(count);
+  std::vector<float> f(count);
+  std::vector<double> d(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto v = (int64_t)((i * 37) % 11) - 5;
+    i32[i] = (int32_t)v;
+    i64[i] = v * 3000000000LL;
+    f[i] = (float)v / 2;
+    d[i] = (double)v / 2;
+  }
+  i32[3] = std::numeric_limits<int32_t>::min();
+  i64[70] = std::numeric_limits<int64_t>::max();
+  f[5] = std::numeric_limits<float>::quiet_NaN();
+  d[66] = std::numeric_limits<double>::quiet_NaN();
+  CheckSelect<int32_t>(i32, 1);
+  CheckSelect<int64_t>(i64, -6000000000LL);
+  CheckSelect<float>(f, 0.5f);
+  CheckSelect<double>(d, -1.0);
+}
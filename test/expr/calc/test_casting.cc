@@ -57,6 +57,46 @@ TEST(TestStringTonumber, Cast) {
   ASSERT_EQ((calc::Cast<double>(DecimalP(std::string("123.45")))), 123.45);
 }
 
+TEST(TestStringTonumber, CastSpacesAndSigns) {
+  ASSERT_EQ((calc::Cast<int32_t>(String("  -12"))), -12);
+  ASSERT_EQ((calc::Cast<int32_t>(String("+12"))), 12);
+  ASSERT_EQ((calc::Cast<int32_t>(String("+-12"))), 0);
+  ASSERT_EQ((calc::Cast<int64_t>(String("12345678901234567x"))), 12345678901234567LL);
+  ASSERT_EQ((calc::Cast<int64_t>(String("-9223372036854775808"))), std::numeric_limits<int64_t>::min());
+  ASSERT_EQ((calc::Cast<double>(String(" -1.5e3abc"))), -1500.0);
+  ASSERT_EQ((calc::Cast<double>(String("0x10"))), 16.0);
+  ASSERT_EQ((calc::Cast<float>(String("+.25"))), 0.25f);
+  ASSERT_EQ((calc::Cast<double>(String("-"))), 0.0);
+  ASSERT_EQ(calc::Cast<DecimalP>(String("-1234567890"))->toString(), "-1234567890");
+  ASSERT_EQ(calc::Cast<DecimalP>(String("12.5"))->toString(), "12.5");
+  ASSERT_THROW(calc::Cast<int32_t>(String("2147483648")), std::out_of_range);
+  ASSERT_THROW(calc::Cast<int64_t>(String("99999999999999999999")), std::out_of_range);
+  ASSERT_THROW(calc::CastCheck<int32_t>(String("-2147483649")), ExceedsLimits<TYPE_INT32>);
+  ASSERT_THROW(calc::CastCheck<double>(String("1e400")), ExceedsLimits<TYPE_DOUBLE>);
+  ASSERT_EQ((calc::CastCheck<int32_t>(String("-2147483648"))), std::numeric_limits<int32_t>::min());
+}
+
+TEST(TestStringTonumber, CastBatch) {
+  const char data[] = "1a  23-445678901234";
+  const int32_t offsets[] = {0, 1, 2, 6, 8, 19};
+  const Byte in_validity[] = {0x1D};
+  int64_t out[5];
+  Byte validity[1];
+  calc::CastBatch(out, validity, offsets, data, in_validity, 5);
+  ASSERT_EQ(validity[0], 0x1D);
+  ASSERT_EQ(out[0], 1);
+  ASSERT_EQ(out[1], 0);
+  ASSERT_EQ(out[2], 23);
+  ASSERT_EQ(out[3], -4);
+  ASSERT_EQ(out[4], 45678901234LL);
+  int32_t out32[5];
+  ASSERT_THROW(calc::CastCheckBatch(out32, validity, offsets, data, nullptr, 5), ExceedsLimits<TYPE_INT32>);
+  DecimalP decimals[5];
+  calc::CastCheckBatch(decimals, validity, offsets, data, in_validity, 5);
+  ASSERT_EQ(validity[0], 0x1D);
+  ASSERT_EQ(decimals[4]->toString(), "45678901234");
+}
+
 TEST(TestToInt32, Cast) {
   ASSERT_THROW(calc::CastCheck<int32_t>((int64_t)std::numeric_limits<int32_t>::max() + 1), ExceedsLimits<TYPE_INT32>);
   ASSERT_THROW(calc::CastCheck<int32_t>((int64_t)std::numeric_limits<int32_t>::min() - 1), ExceedsLimits<TYPE_INT32>);
@@ -87,8 +127,9 @@ TEST(TestOtherToDecimalP, Cast) {
   //ASSERT_EQ((calc::Cast<double>(DecimalP(std::string("0")))), 0);
 
   //ASSERT_EQ((calc::Cast<String>(DecimalP(std::string("0")))), "0");
-  ASSERT_EQ((calc::Cast<String>(DecimalP(std::string("-123456.123456789")))), "-123456.123456789000000000000000");
-  ASSERT_EQ((calc::Cast<String>(DecimalP(std::string("123456.123456789")))), "123456.123456789000000000000000");
+  // Without precision and scale, the value is cast as it is.
+  ASSERT_EQ((calc::Cast<String>(DecimalP(std::string("-123456.123456789")))), "-123456.123456789");
+  ASSERT_EQ((calc::Cast<String>(DecimalP(std::string("123456.123456789")))), "123456.123456789");
 
   DecimalP decimal1 = DecimalP(std::string("123456.123456789"));
   decimal1.setDecimalPrecision(15);
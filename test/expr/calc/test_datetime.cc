@@ -0,0 +1,56 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+#include "batch.h"
+#include "datetime.h"
+
+using namespace dingodb::expr;
+
+TEST(TestDateTime, CivilCalendar) {
+  // Every 7 hours from 1600 to 2400, against the C library.
+  for (int64_t s = -11676096000LL; s < 13569465600LL; s += 7 * 3600 + 13) {
+    time_t t = s;
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    int64_t millis = s * 1000 + 999;
+    ASSERT_EQ(calc::Year(millis), tm.tm_year + 1900) << s;
+    ASSERT_EQ(calc::Month(millis), tm.tm_mon + 1) << s;
+    ASSERT_EQ(calc::Day(millis), tm.tm_mday) << s;
+    ASSERT_EQ(calc::DayOfWeek(millis), tm.tm_wday + 1) << s;
+    ASSERT_EQ(calc::Hour(millis), tm.tm_hour) << s;
+    ASSERT_EQ(calc::Minute(millis), tm.tm_min) << s;
+    ASSERT_EQ(calc::Second(millis), tm.tm_sec) << s;
+    ASSERT_EQ(calc::TruncMonth(millis), (s - ((tm.tm_mday - 1) * 86400LL + tm.tm_hour * 3600 + tm.tm_min * 60 +
+                                              tm.tm_sec)) * 1000) << s;
+    ASSERT_EQ(calc::TruncYear(millis), (s - (tm.tm_yday * 86400LL + tm.tm_hour * 3600 + tm.tm_min * 60 +
+                                             tm.tm_sec)) * 1000) << s;
+  }
+}
+
+TEST(TestDateTime, Batch) {
+  std::vector<int64_t> in{0, -1, 1580616732000, 951782400000};  // 2000-02-29
+  Byte validity[] = {0x0B};
+  std::vector<int32_t> months(in.size());
+  EXPECT_EQ((calc::UnaryBatch<TYPE_INT32, TYPE_TIMESTAMP, calc::Month>(months.data(), in.data(), validity, 4)),
+            validity);
+  EXPECT_EQ(months, (std::vector<int32_t>{1, 12, 0, 2}));
+  std::vector<int64_t> days(in.size());
+  calc::UnaryBatch<TYPE_TIMESTAMP, TYPE_TIMESTAMP, calc::TruncDay>(days.data(), in.data(), nullptr, 4);
+  EXPECT_EQ(days, (std::vector<int64_t>{0, -86400000, 1580601600000, 951782400000}));
+}
@@ -81,6 +81,7 @@ static Tuple tuple6{1, 1, nullptr};
 static Tuple tuple7{1, 1580616732000, 1580620393000};   //2020-02-02 12:12:12, 2020-02-02 13:13:13
 static Tuple tuple8{1, 1580616732000, 1580616732000};   //2020-02-02 12:12:12, 2020-02-02 12:12:12
 static Tuple tuple9{1, nullptr, nullptr};
+static Tuple tuple10{1, -1LL};  // 1969-12-31 23:59:59.999
 
 static Tuple tupleDec1{std::make_shared<Decimal>(Decimal("123.123")), std::make_shared<Decimal>(Decimal("456.456"))};
 static Tuple tupleDec2{std::make_shared<Decimal>(Decimal("123.123")), std::make_shared<Decimal>(Decimal("123.123"))};
@@ -244,3 +245,173 @@ INSTANTIATE_TEST_SUITE_P(
         // is_false(TIMESTAMP(null))
         std::make_tuple("3901A30900", &tuple9, false)
         ));
+
+// Date and time functions.
+INSTANTIATE_TEST_SUITE_P(
+    DateTimeExpr,
+    ExprTest,
+    testing::Values(
+        std::make_tuple("3901F136", &tuple7, 2020),                 // year($[1])
+        std::make_tuple("3901F137", &tuple7, 1),                    // quarter($[1])
+        std::make_tuple("3901F138", &tuple7, 2),                    // month($[1])
+        std::make_tuple("3901F139", &tuple7, 2),                    // day($[1])
+        std::make_tuple("3901F13A", &tuple7, 1),                    // day_of_week($[1]), Sunday
+        std::make_tuple("3901F13B", &tuple7, 4),                    // hour($[1]), UTC
+        std::make_tuple("3901F13C", &tuple7, 12),                   // minute($[1])
+        std::make_tuple("3901F13D", &tuple7, 12),                   // second($[1])
+        std::make_tuple("3901F140", &tuple7, 1580515200000LL),      // date_trunc('month', $[1])
+        std::make_tuple("3901F141", &tuple7, 1580083200000LL),      // date_trunc('week', $[1])
+        std::make_tuple("3901F136", &tuple9, nullptr),              // year(null)
+        std::make_tuple("3901F136", &tuple10, 1969),                // year($[1]), before the epoch
+        std::make_tuple("3901F139", &tuple10, 31),                  // day($[1])
+        std::make_tuple("3901F13B", &tuple10, 23),                  // hour($[1])
+        std::make_tuple("3901F142", &tuple10, -86400000LL)          // date_trunc('day', $[1])
+        ));
+
+// Comparing variables with constants, which are fused at decoding.
+INSTANTIATE_TEST_SUITE_P(
+    FusedExpr,
+    ExprTest,
+    testing::Values(
+        std::make_tuple("310011059501", &tuple1, true),                          // $[0] < 5
+        std::make_tuple("110531009501", &tuple1, false),                         // 5 < $[0]
+        std::make_tuple("310111029101", &tuple1, true),                          // $[1] == 2
+        std::make_tuple("320212059302", &tuple6, nullptr),                       // $[2] > 5, $[2] is null
+        std::make_tuple("120532029302", &tuple6, nullptr),                       // 5 > $[2], $[2] is null
+        std::make_tuple("370017036162639107", &tuple4, true),                    // $[0] == 'abc'
+        std::make_tuple("31001100930131011103950152", &tuple1, true),            // $[0] > 0 && $[1] < 3
+        std::make_tuple("310031019501", &tuple1, true)                           // $[0] < $[1], not fused
+        ));
+
+TEST(ExprVarTest, VarsAndLazyRow) {
+  // $[3] + $[1] + $[3]
+  std::string input = "31033101830131038301";
+  Runner runner;
+  auto len = input.size() / 2;
+  Byte buf[len];
+  HexToBytes(buf, input.data(), input.size());
+  runner.Decode(buf, len);
+  EXPECT_EQ(runner.GetVars(), (std::vector<VarInfo>{{3, TYPE_INT32}, {1, TYPE_INT32}}));
+  int decoded = 0;
+  int base = 0;
+  LazyRow row(50, [&decoded, &base](int32_t index) -> Operand {
+    ++decoded;
+    return base + index * 10;
+  });
+  runner.BindRow(&row);
+  runner.Run();
+  EXPECT_EQ(runner.Get(), 70);
+  EXPECT_EQ(decoded, 2);
+  base = 1;
+  row.Reset();
+  runner.Run();
+  EXPECT_EQ(runner.Get(), 73);
+  EXPECT_EQ(decoded, 4);
+}
+
+TEST(ExprCseTest, CommonSubexpressions) {
+  // ($[0] + $[1]) * ($[0] + $[1]), $[0] + $[1], $[1] * 2
+  std::string input = "3100310183013100310183018501310031018301310111028501";
+  Runner runner;
+  auto len = input.size() / 2;
+  Byte buf[len];
+  HexToBytes(buf, input.data(), input.size());
+  runner.Decode(buf, len);
+  runner.BindTuple(&tuple1);
+  runner.Run();
+  EXPECT_EQ(Tuple(runner.begin(), runner.end()), (Tuple{9, 3, 4}));
+  // Run again to reuse the temporary slots.
+  Tuple tuple{2, 3};
+  runner.BindTuple(&tuple);
+  runner.Run();
+  EXPECT_EQ(Tuple(runner.begin(), runner.end()), (Tuple{25, 5, 6}));
+  // Get into a caller-owned tuple.
+  Tuple output{1, 2, 3, 4};
+  runner.GetAll(output);
+  EXPECT_EQ(output, (Tuple{25, 5, 6}));
+}
+
+TEST(ExprProfileTest, Counters) {
+  // $[0] >= 10 && $[0] < 1000
+  std::string input = "3100110A9201310011E807950152";
+  Runner runner;
+  auto len = input.size() / 2;
+  Byte buf[len];
+  HexToBytes(buf, input.data(), input.size());
+  runner.Decode(buf, len);
+  EXPECT_TRUE(runner.GetProfile().empty());
+  runner.EnableProfiling();
+  Tuple tuples[] = {{5}, {50}, {nullptr}};
+  for (const auto &tuple : tuples) {
+    runner.BindTuple(&tuple);
+    runner.Run();
+  }
+  EXPECT_EQ(runner.Get(), nullptr);
+  const auto &profile = runner.GetProfile();
+  ASSERT_EQ(profile.size(), 3);
+  for (const auto &p : profile) {
+    EXPECT_EQ(p.calls, 3);
+    EXPECT_EQ(p.nulls, 1);
+  }
+  auto disassembly = runner.Disassemble();
+  EXPECT_NE(disassembly.find("$[0], 10"), std::string::npos);
+  EXPECT_NE(disassembly.find("AndOperator"), std::string::npos);
+  EXPECT_NE(runner.DumpProfile().find("calls"), std::string::npos);
+  runner.EnableProfiling(false);
+  runner.Run();
+  EXPECT_TRUE(runner.GetProfile().empty());
+}
+
+enum VerifyError { STACK_UNDERFLOW, OPERAND_TYPE_MISMATCH };
+
+// The code, the error and the message after the name of the operator, which depends on the compiler.
+class ExprVerifyTest : public testing::TestWithParam<std::tuple<std::string, VerifyError, std::string>> {};
+
+TEST_P(ExprVerifyTest, Invalid) {
+  const auto &[input, error, message] = GetParam();
+  Runner runner;
+  auto len = input.size() / 2;
+  Byte buf[len];
+  HexToBytes(buf, input.data(), input.size());
+  try {
+    runner.Decode(buf, len);
+    ADD_FAILURE() << "Not rejected.";
+  } catch (const StackUnderflow &e) {
+    EXPECT_EQ(error, STACK_UNDERFLOW) << e.what();
+    EXPECT_NE(std::string(e.what()).find(message), std::string::npos) << e.what();
+  } catch (const OperandTypeMismatch &e) {
+    EXPECT_EQ(error, OPERAND_TYPE_MISMATCH) << e.what();
+    EXPECT_NE(std::string(e.what()).find(message), std::string::npos) << e.what();
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    InvalidExpr,
+    ExprVerifyTest,
+    testing::Values(
+        // ? + ?
+        std::make_tuple("8301", STACK_UNDERFLOW, ") requires 2 operands, but only 0 on the stack."),
+        // 1 + ?
+        std::make_tuple("11018301", STACK_UNDERFLOW, ") requires 2 operands, but only 1 on the stack."),
+        // 1 + 'a'
+        std::make_tuple("11011701618301", OPERAND_TYPE_MISMATCH, ") must be INT32, but is STRING."),
+        // 1 + 1L
+        std::make_tuple("110112018301", OPERAND_TYPE_MISMATCH, ") must be INT32, but is INT64."),
+        // 1 && ?
+        std::make_tuple("110152", STACK_UNDERFLOW, "Operator #1 (AndOperator) requires 2 operands, but only 1 on"),
+        // 1 && 1
+        std::make_tuple("1101110152", OPERAND_TYPE_MISMATCH, "Operand 0 of operator #2 (AndOperator) must be BOOL")
+    )
+);
+
+TEST(ExprStackTest, Deep) {
+  // 1 + (2 + (3 + 4)), 5
+  std::string input = "11011102110311048301830183011105";
+  Runner runner;
+  auto len = input.size() / 2;
+  Byte buf[len];
+  HexToBytes(buf, input.data(), input.size());
+  runner.Decode(buf, len);
+  runner.Run();
+  EXPECT_EQ(Tuple(runner.begin(), runner.end()), (Tuple{10, 5}));
+}
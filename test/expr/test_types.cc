@@ -15,7 +15,11 @@
 #include <gtest/gtest.h>
 
 #include <functional>
+#include <set>
+#include <vector>
 
+#include "expr/calc/batch.h"
+#include "expr/operand.h"
 #include "expr/types.h"
 
 using namespace dingodb::expr;
@@ -30,3 +34,67 @@ TEST(TestTypes, StringEquals) {
   ASSERT_TRUE(std::equal_to()(s0, s1));
   ASSERT_EQ(s0, s1);
 }
+
+TEST(TestTypes, StringSlice) {
+  String s{"Hello, Alice"};
+  auto slice = s.Slice(7);
+  ASSERT_TRUE(slice.IsSlice());
+  ASSERT_EQ(slice.View(), "Alice");
+  ASSERT_EQ(slice.Length(), 5);
+  ASSERT_EQ(slice.Slice(1, 3).View(), "lic");
+  ASSERT_EQ(slice, String("Alice"));
+  ASSERT_EQ(std::hash<String>()(slice), std::hash<String>()(String("Alice")));
+  ASSERT_LT(slice, String("Betty"));
+  ASSERT_FALSE(s.Slice(0).IsSlice());
+  ASSERT_THROW(s.Slice(13), std::out_of_range);
+  // A slice is copied only explicitly, and is not changed by the copying.
+  auto view = slice.View();
+  ASSERT_THROW(*slice, std::logic_error);
+  ASSERT_EQ(*slice.GetPtr(), "Alice");
+  ASSERT_EQ(*slice.Detached(), "Alice");
+  ASSERT_TRUE(slice.IsSlice());
+  ASSERT_EQ(view.data(), slice.View().data());
+  // The whole string is referred to, not copied.
+  ASSERT_EQ(&*s, s.GetPtr().get());
+  ASSERT_EQ(s->length(), 12);
+}
+
+TEST(TestHash, Bytes) {
+  std::string data;
+  for (int i = 0; i < 100; ++i) {
+    data.push_back(static_cast<char>('a' + i % 26));
+  }
+  // Prefixes of all lengths, through all the paths of reading.
+  std::set<uint64_t> hashes;
+  for (size_t len = 0; len <= data.size(); ++len) {
+    hashes.insert(HashBytes(data.data(), len));
+  }
+  EXPECT_EQ(hashes.size(), data.size() + 1);
+  EXPECT_EQ(HashValue(String("Hello, Alice").Slice(7)), HashValue(String("Alice")));
+  EXPECT_NE(HashBytes("Alice", 5), HashBytes("Alice", 5, HASH_SEED + 1));
+}
+
+TEST(TestHash, Operands) {
+  EXPECT_EQ(std::hash<Operand>()(-0.0), std::hash<Operand>()(0.0));
+  EXPECT_EQ(std::hash<Operand>()(String("abc")), std::hash<String>()(String("abc")));
+  EXPECT_EQ(std::hash<Operand>()(DecimalP(std::string("1.50"))), std::hash<Operand>()(DecimalP(std::string("1.5"))));
+  EXPECT_NE(std::hash<Operand>()(nullptr), std::hash<Operand>()(0));
+  // Low bits of sequential integers are spread, nearly as random ones (about 2589 of 4096 buckets are hit).
+  std::set<uint64_t> buckets;
+  for (int32_t i = 0; i < 4096; ++i) {
+    buckets.insert(std::hash<Tuple>()(Tuple{i}) & 4095);
+  }
+  EXPECT_GT(buckets.size(), 2400);
+}
+
+TEST(TestHash, Batch) {
+  std::vector<int64_t> keys0{1, 2, 3, 4};
+  std::vector<double> keys1{0.5, 1.5, 2.5, 3.5};
+  Byte validity1[] = {0x0D};
+  std::vector<uint64_t> hashes(4, HASH_SEED);
+  calc::HashBatch(hashes.data(), keys0.data(), nullptr, 4);
+  calc::HashBatch(hashes.data(), keys1.data(), validity1, 4);
+  EXPECT_EQ(hashes[0], HashValue(Tuple{1LL, 0.5}));
+  EXPECT_EQ(hashes[1], HashValue(Tuple{2LL, nullptr}));
+  EXPECT_EQ(hashes[3], std::hash<Tuple>()(Tuple{4LL, 3.5}));
+}
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <map>
 
 #include "expr/codec.h"
 #include "rel/rel_runner.h"
@@ -321,3 +322,327 @@ INSTANTIATE_TEST_SUITE_P(
         )
     )
 );
+
+TEST(BatchTest, FilterProject) {
+  // PROJECT(FILTER(input, $[2] > 50), $[0], $[1], $[2] / 10)
+  const auto *rel = MakeRunner("7134021442480000930400723100370134021441200000860400");
+  auto data = MakeData();
+  Batch batch(data.data(), data.size());
+  rel->Put(batch);
+  const auto &selection = batch.GetSelection();
+  ASSERT_EQ(selection.size(), 3);
+  EXPECT_EQ(*batch.GetTuple(selection[0]), (Tuple{6, "Alice", 6.0f}));
+  EXPECT_EQ(*batch.GetTuple(selection[1]), (Tuple{7, "Betty", 7.0f}));
+  EXPECT_EQ(*batch.GetTuple(selection[2]), (Tuple{8, "Alice", 8.0f}));
+  // The input tuples are borrowed.
+  EXPECT_EQ(*data[5], (Tuple{6, "Alice", 60.0f}));
+  delete rel;
+  ReleaseData(data);
+}
+
+TEST(BatchTest, FilterSelection) {
+  // FILTER(input, $[2] > 50)
+  const auto *rel = MakeRunner("7134021442480000930400");
+  auto data = MakeData();
+  Batch batch(data.data(), data.size());
+  rel->Put(batch);
+  EXPECT_EQ(batch.GetSelection(), (Selection{5, 6, 7}));
+  EXPECT_EQ(batch.GetTuple(5), data[5]);
+  delete rel;
+  ReleaseData(data);
+}
+
+TEST(BatchTest, GroupedAgg) {
+  // AGG(input, GROUP(1), COUNT(), SUM($[2]))
+  const auto *rel = MakeRunner("7361010102102402");
+  auto data = MakeData();
+  Batch batch(data.data(), data.size());
+  rel->Put(batch);
+  EXPECT_TRUE(batch.Empty());
+  Data result{
+      new Tuple{"Alice", 3LL, 150.0f},
+      new Tuple{"Betty", 2LL, 90.0f},
+      new Tuple{"Cindy", 2LL, 30.0f},
+      new Tuple{"Doris", 1LL, 40.0f},
+      new Tuple{"Emily", 1LL, 50.0f},
+  };
+  for (int i = 0; i < result.size(); ++i) {
+    const auto *out = rel->Get();
+    ASSERT_NE(out, nullptr);
+    EXPECT_TRUE(std::any_of(result.cbegin(), result.cend(), [out](const Tuple *t) { return *t == *out; }));
+    delete out;
+  }
+  EXPECT_EQ(rel->Get(), nullptr);
+  delete rel;
+  ReleaseData(data);
+  ReleaseData(result);
+}
+
+TEST(ProjectTest, PassThrough) {
+  // PROJECT(input, $[1], $[0] * 2, $[1])
+  const auto *rel = MakeRunner("7237013100110285013701");
+  const auto *out = rel->Put(new Tuple{3, "Cindy", 30.0f});
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, (Tuple{"Cindy", 6, "Cindy"}));
+  delete out;
+  auto data = MakeData();
+  Batch batch(data.data(), data.size());
+  rel->Put(batch);
+  ASSERT_EQ(batch.GetSelection().size(), data.size());
+  EXPECT_EQ(*batch.GetTuple(4), (Tuple{"Emily", 10, "Emily"}));
+  // The input tuples are borrowed.
+  EXPECT_EQ(*data[4], (Tuple{5, "Emily", 50.0f}));
+  delete rel;
+  ReleaseData(data);
+}
+
+TEST(TuplePoolTest, Reuse) {
+  // AGG(FILTER(input, $[2] > 50), GROUP(1), COUNT(), SUM($[2]))
+  const auto *rel = MakeRunner("71340214424800009304007361010102102402");
+  auto *rejected = rel->AcquireTuple();
+  *rejected = Tuple{1, "Alice", 10.0f};
+  EXPECT_EQ(rel->Put(rejected), nullptr);
+  // The rejected tuple is recycled.
+  auto *tuple = rel->AcquireTuple();
+  EXPECT_EQ(tuple, rejected);
+  EXPECT_TRUE(tuple->empty());
+  *tuple = Tuple{6, "Alice", 60.0f};
+  EXPECT_EQ(rel->Put(tuple), nullptr);
+  EXPECT_EQ(rel->Put(new Tuple{8, "Alice", 80.0f}), nullptr);
+  const auto *out = rel->Get();
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, (Tuple{"Alice", 2LL, 140.0f}));
+  EXPECT_EQ(rel->Get(), nullptr);
+  rel->ReleaseTuple(out);
+  delete rel;
+}
+
+TEST(UniquePtrTest, GroupedAgg) {
+  // AGG(input, GROUP(1), COUNT(), SUM($[2]))
+  const auto *rel = MakeRunner("7361010102102402");
+  for (const auto *t : MakeData()) {
+    EXPECT_EQ(rel->PutTuple(TuplePtr(const_cast<Tuple *>(t))), nullptr);
+  }
+  std::vector<Tuple> result;
+  TuplePtr out;
+  while ((out = rel->GetTuple()) != nullptr) {
+    result.push_back(std::move(*out));
+  }
+  ASSERT_EQ(result.size(), 5);
+  EXPECT_TRUE(std::find(result.begin(), result.end(), Tuple{"Alice", 3LL, 150.0f}) != result.end());
+  EXPECT_TRUE(std::find(result.begin(), result.end(), Tuple{"Emily", 1LL, 50.0f}) != result.end());
+  delete rel;
+}
+
+TEST(DrainTest, GroupedAgg) {
+  // AGG(input, GROUP(1), COUNT(), SUM($[2]))
+  const auto *rel = MakeRunner("7361010102102402");
+  auto data = MakeData();
+  Batch batch(data.data(), data.size());
+  rel->Put(batch);
+  std::vector<Tuple> result;
+  while (true) {
+    rel->Drain(batch, 2);
+    if (batch.Empty()) {
+      break;
+    }
+    EXPECT_LE(batch.GetSelection().size(), 2);
+    for (auto i : batch.GetSelection()) {
+      result.push_back(*batch.GetTuple(i));
+    }
+  }
+  EXPECT_EQ(rel->Get(), nullptr);
+  // The keys moved into the outputs are valid without the operator and the input.
+  delete rel;
+  ReleaseData(data);
+  ASSERT_EQ(result.size(), 5);
+  EXPECT_TRUE(std::find(result.begin(), result.end(), Tuple{"Betty", 2LL, 90.0f}) != result.end());
+  EXPECT_TRUE(std::find(result.begin(), result.end(), Tuple{"Doris", 1LL, 40.0f}) != result.end());
+  // PROJECT(AGG(input, GROUP(1), COUNT(), SUM($[2])), $[1])
+  rel = MakeRunner("736101010210240272320100");
+  data = MakeData();
+  batch.Reset(data.data(), data.size());
+  rel->Put(batch);
+  EXPECT_TRUE(batch.Empty());
+  int64_t count = 0;
+  for (rel->Drain(batch, 3); !batch.Empty(); rel->Drain(batch, 3)) {
+    for (auto i : batch.GetSelection()) {
+      count += batch.GetTuple(i)->at(0).GetValue<int64_t>();
+    }
+  }
+  EXPECT_EQ(count, data.size());
+  ReleaseData(data);
+  delete rel;
+}
+
+TEST(DecimalSumTest, GroupedAgg) {
+  // AGG(input, GROUP(0), SUM($[1]))
+  const auto *rel = MakeRunner("73610100012601");
+  auto d = [](const char *v) { return DecimalP(std::string(v)); };
+  Data data{
+      new Tuple{1, d("12.34")},
+      new Tuple{2, d("90000000000000000000000000000000000000")},
+      new Tuple{1, d("0.005")},
+      new Tuple{3, nullptr},
+      new Tuple{2, d("90000000000000000000000000000000000000")},
+      new Tuple{1, d("-1")},
+      new Tuple{2, d("90000000000000000000000000000000000000")},
+      new Tuple{1, d("100")},
+      new Tuple{4, d("-100000000000000000000.5")},
+      new Tuple{4, d("-100000000000000000000.5")},
+  };
+  Batch batch(data.data(), data.size());
+  rel->Put(batch);
+  std::map<int32_t, Operand> sums;
+  for (rel->Drain(batch, 10); !batch.Empty(); rel->Drain(batch, 10)) {
+    for (auto i : batch.GetSelection()) {
+      sums[(*batch.GetTuple(i))[0].GetValue<int32_t>()] = (*batch.GetTuple(i))[1];
+    }
+  }
+  ASSERT_EQ(sums.size(), 4);
+  EXPECT_EQ(sums[1].GetValue<DecimalP>().ToString(), "111.345");
+  // Beyond 64 bits.
+  EXPECT_EQ(sums[4].GetValue<DecimalP>(), d("-200000000000000000001"));
+  // Overflowing 128-bit integers.
+  EXPECT_EQ(sums[2].GetValue<DecimalP>(), d("270000000000000000000000000000000000000"));
+  EXPECT_EQ(sums[3], nullptr);
+  // The accumulators are kept in the caches of the groups, and dropped from the outputs.
+  batch.Reset(data.data(), 2);
+  rel->Put(batch);
+  const auto *out = rel->Get();
+  const auto *out1 = rel->Get();
+  EXPECT_EQ(rel->Get(), nullptr);
+  EXPECT_EQ(out->size(), 2);
+  EXPECT_EQ(((*out)[0] == 1 ? *out : *out1)[1].GetValue<DecimalP>().ToString(), "12.34");
+  delete out;
+  delete out1;
+  ReleaseData(data);
+  delete rel;
+}
+
+TEST(StatsTest, FilterGroupedAgg) {
+  // AGG(FILTER(input, $[2] > 50), GROUP(1), COUNT(), SUM($[2]))
+  std::string code = "71340214424800009304007361010102102402";
+  Byte buf[code.size() / 2];
+  HexToBytes(buf, code.data(), code.size());
+  auto *rel = new RelRunner();
+  // Kept for decoding.
+  rel->EnableTiming();
+  rel->EnableProbeStats();
+  rel->Decode(buf, sizeof(buf));
+  auto data = MakeData();
+  for (auto *tuple : data) {
+    EXPECT_EQ(rel->Put(tuple), nullptr);
+  }
+  auto stats = rel->GetStats();
+  ASSERT_EQ(stats.size(), 2);
+  EXPECT_STREQ(stats[0].name, "FILTER");
+  EXPECT_EQ(stats[0].rows_in, 9);
+  EXPECT_EQ(stats[0].rows_out, 3);
+  EXPECT_DOUBLE_EQ(stats[0].Selectivity(), 3.0 / 9.0);
+  EXPECT_GT(stats[0].nanos, 0);
+  EXPECT_STREQ(stats[1].name, "GROUPED_AGG");
+  EXPECT_EQ(stats[1].rows_in, 3);
+  EXPECT_EQ(stats[1].groups, 2);
+  EXPECT_GE(stats[1].max_probe_length, 1);
+  EXPECT_GT(stats[1].peak_bytes, 0);
+  while (const auto *out = rel->Get()) {
+    delete out;
+  }
+  // Kept after draining.
+  stats = rel->GetStats();
+  EXPECT_EQ(stats[1].rows_out, 2);
+  EXPECT_EQ(stats[1].groups, 2);
+  EXPECT_GT(stats[1].load_factor, 0.0);
+  EXPECT_GE(stats[1].mean_probe_length, 1.0);
+  delete rel;
+  // Without probe lengths, draining does not walk the buckets even if timed, and the peak bytes are kept as groups are
+  // added.
+  rel = new RelRunner();
+  rel->EnableTiming();
+  rel->Decode(buf, sizeof(buf));
+  for (auto *tuple : MakeData()) {
+    EXPECT_EQ(rel->Put(tuple), nullptr);
+  }
+  auto peak_bytes = rel->GetStats()[1].peak_bytes;
+  EXPECT_GT(peak_bytes, 0);
+  while (const auto *out = rel->Get()) {
+    delete out;
+  }
+  stats = rel->GetStats();
+  EXPECT_EQ(stats[1].groups, 2);
+  EXPECT_EQ(stats[1].mean_probe_length, 0.0);
+  EXPECT_EQ(stats[1].peak_bytes, peak_bytes);
+  delete rel;
+}
+
+class CollectingSink : public Sink {
+ public:
+  void Consume(const Batch &batch) override {
+    ++batches;
+    for (auto i : batch.GetSelection()) {
+      tuples.push_back(*batch.GetTuple(i));
+    }
+  }
+
+  void Finish() override {
+    ++finished;
+  }
+
+  std::vector<Tuple> tuples;
+  int batches = 0;
+  int finished = 0;
+};
+
+TEST(SinkTest, FilterProject) {
+  // PROJECT(FILTER(input, $[2] > 50), $[0], $[1], $[2] / 10)
+  std::string code = "7134021442480000930400723100370134021441200000860400";
+  Byte buf[code.size() / 2];
+  HexToBytes(buf, code.data(), code.size());
+  RelRunner rel;
+  CollectingSink sink;
+  // Kept for decoding.
+  rel.SetSink(&sink);
+  rel.Decode(buf, sizeof(buf));
+  auto data = MakeData();
+  Batch batch(data.data(), 3);
+  // Nothing pushed for empty outputs.
+  rel.Put(batch);
+  EXPECT_EQ(sink.batches, 0);
+  batch.Reset(data.data() + 3, data.size() - 3);
+  rel.Put(batch);
+  EXPECT_EQ(sink.batches, 1);
+  EXPECT_EQ(sink.tuples, (std::vector<Tuple>{{6, "Alice", 6.0f}, {7, "Betty", 7.0f}, {8, "Alice", 8.0f}}));
+  // Still the outputs of the batch.
+  EXPECT_EQ(batch.GetSelection().size(), 3);
+  rel.Finish();
+  EXPECT_EQ(sink.batches, 1);
+  EXPECT_EQ(sink.finished, 1);
+  ReleaseData(data);
+}
+
+TEST(SinkTest, GroupedAgg) {
+  // AGG(input, GROUP(1), COUNT(), SUM($[2]))
+  std::string code = "7361010102102402";
+  Byte buf[code.size() / 2];
+  HexToBytes(buf, code.data(), code.size());
+  RelRunner rel;
+  rel.Decode(buf, sizeof(buf));
+  int64_t count = 0;
+  size_t max_size = 0;
+  CallbackSink sink([&](const Batch &batch) {
+    max_size = std::max(max_size, batch.GetSelection().size());
+    for (auto i : batch.GetSelection()) {
+      count += (*batch.GetTuple(i))[1].GetValue<int64_t>();
+    }
+  });
+  rel.SetSink(&sink);
+  auto data = MakeData();
+  Batch batch(data.data(), data.size());
+  rel.Put(batch);
+  EXPECT_EQ(count, 0);
+  rel.Finish(2);
+  EXPECT_EQ(count, data.size());
+  EXPECT_EQ(max_size, 2);
+  ReleaseData(data);
+}
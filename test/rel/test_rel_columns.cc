@@ -0,0 +1,362 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+
+#include "expr/codec.h"
+#include "rel/column_batch.h"
+#include "rel/rel_runner.h"
+
+using namespace dingodb::expr;
+using namespace dingodb::rel;
+
+static const RelRunner *MakeRunner(const std::string &code) {
+  auto len = code.size() / 2;
+  Byte buf[len];
+  HexToBytes(buf, code.data(), code.size());
+  auto *rel = new RelRunner();
+  rel->Decode(buf, len);
+  return rel;
+}
+
+static void MakeColumns(struct ArrowSchema *schema, struct ArrowArray *array) {
+  ColumnBatchBuilder builder;
+  builder.Append(Tuple{1, "Alice", 10.0f});
+  builder.Append(Tuple{2, nullptr, 60.0f});
+  builder.Append(Tuple{nullptr, "Cindy", nullptr});
+  builder.Append(Tuple{4, "Doris", 80.0f});
+  builder.Finish(schema, array);
+}
+
+TEST(ColumnBatchTest, RoundTrip) {
+  struct ArrowSchema schema;
+  struct ArrowArray array;
+  MakeColumns(&schema, &array);
+  ASSERT_STREQ(schema.format, "+s");
+  ASSERT_EQ(schema.n_children, 3);
+  EXPECT_STREQ(schema.children[0]->format, "i");
+  EXPECT_STREQ(schema.children[1]->format, "u");
+  EXPECT_STREQ(schema.children[2]->format, "f");
+  EXPECT_EQ(array.length, 4);
+  EXPECT_EQ(array.children[1]->null_count, 1);
+  const auto *data = static_cast<const char *>(array.children[1]->buffers[2]);
+  ColumnBatch columns(&schema, &array);
+  EXPECT_EQ(schema.release, nullptr);
+  EXPECT_EQ(array.release, nullptr);
+  ASSERT_EQ(columns.Size(), 4);
+  EXPECT_EQ(columns.GetType(1), TYPE_STRING);
+  EXPECT_EQ(columns.GetOperand(0, 1), 2);
+  EXPECT_EQ(columns.GetOperand(0, 2), nullptr);
+  EXPECT_EQ(columns.GetOperand(1, 0), "Alice");
+  EXPECT_EQ(columns.GetOperand(1, 1), nullptr);
+  EXPECT_EQ(columns.GetOperand(2, 3), 80.0f);
+  auto name = columns.GetOperand(1, 2);
+  EXPECT_EQ(name, "Cindy");
+  // Strings are slices of the data buffer of the array, not copies.
+  EXPECT_TRUE(name.GetValue<String>().IsSlice());
+  EXPECT_EQ(name.GetValue<String>().View().data(), data + 5);
+}
+
+TEST(ColumnBatchTest, ValuesOutliveBatch) {
+  // AGG(input, GROUP(1), COUNT(), SUM($[2]))
+  const auto *rel = MakeRunner("7361010102102402");
+  Operand name;
+  {
+    struct ArrowSchema schema;
+    struct ArrowArray array;
+    MakeColumns(&schema, &array);
+    ColumnBatch columns(&schema, &array);
+    name = columns.GetOperand(1, 3);
+    Batch batch;
+    rel->Put(columns, batch);
+  }
+  // The slice keeps the array alive.
+  EXPECT_EQ(name, "Doris");
+  EXPECT_TRUE(name.GetValue<String>().IsSlice());
+  // The grouping keys are detached, not holding the array.
+  size_t count = 0;
+  for (TuplePtr tuple; (tuple = rel->GetTuple()) != nullptr; ++count) {
+    const auto &key = (*tuple)[0];
+    EXPECT_TRUE(key == nullptr || !key.GetValue<String>().IsSlice());
+  }
+  EXPECT_EQ(count, 4);
+  delete rel;
+}
+
+TEST(ColumnBatchTest, FilterProject) {
+  // PROJECT(FILTER(input, $[2] > 50), $[0], $[1], $[2] / 10)
+  const auto *rel = MakeRunner("7134021442480000930400723100370134021441200000860400");
+  struct ArrowSchema schema;
+  struct ArrowArray array;
+  MakeColumns(&schema, &array);
+  ColumnBatch columns(&schema, &array);
+  Batch batch;
+  rel->Put(columns, batch);
+  ColumnBatchBuilder builder({TYPE_INT32, TYPE_STRING, TYPE_FLOAT});
+  builder.Append(batch);
+  builder.Finish(&schema, &array);
+  ColumnBatch output(&schema, &array);
+  ASSERT_EQ(output.Size(), 2);
+  EXPECT_EQ(output.GetOperand(0, 0), 2);
+  EXPECT_EQ(output.GetOperand(1, 0), nullptr);
+  EXPECT_EQ(output.GetOperand(2, 0), 6.0f);
+  EXPECT_EQ(output.GetOperand(0, 1), 4);
+  EXPECT_EQ(output.GetOperand(1, 1), "Doris");
+  EXPECT_EQ(output.GetOperand(2, 1), 8.0f);
+  delete rel;
+}
+
+static void ReleaseStatic(struct ArrowArray *array) {
+  array->release = nullptr;
+}
+
+static void ReleaseStatic(struct ArrowSchema *schema) {
+  schema->release = nullptr;
+}
+
+TEST(ColumnBatchTest, ImportTypes) {
+  int32_t dates[] = {0, 19723, 19724};
+  int64_t timestamps[] = {0, 1704067200000000LL, 1704067200001000LL};
+  __int128 decimals[] = {0, -12345, 100};
+  const void *date_buffers[] = {nullptr, dates};
+  const void *timestamp_buffers[] = {nullptr, timestamps};
+  const void *decimal_buffers[] = {nullptr, decimals};
+  struct ArrowSchema date_schema = {"tdD", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowSchema timestamp_schema = {"tsu:UTC", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowSchema decimal_schema = {"d:10,2", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowSchema *schema_children[] = {&date_schema, &timestamp_schema, &decimal_schema};
+  struct ArrowSchema schema = {"+s", "", nullptr, 0, 3, schema_children, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray date_array = {3, 0, 0, 2, 0, date_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray timestamp_array = {3, 0, 0, 2, 0, timestamp_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray decimal_array = {3, 0, 0, 2, 0, decimal_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray *array_children[] = {&date_array, &timestamp_array, &decimal_array};
+  const void *buffers[] = {nullptr};
+  // Offset of the struct applies to all the children.
+  struct ArrowArray array = {2, 0, 1, 1, 3, buffers, array_children, nullptr, ReleaseStatic, nullptr};
+  ColumnBatch columns(&schema, &array);
+  ASSERT_EQ(columns.Size(), 2);
+  EXPECT_EQ(columns.GetType(0), TYPE_DATE);
+  EXPECT_EQ(columns.GetOperand(0, 0), 1704067200000LL);
+  EXPECT_EQ(columns.GetType(1), TYPE_TIMESTAMP);
+  EXPECT_EQ(columns.GetOperand(1, 1), 1704067200001LL);
+  EXPECT_EQ(columns.GetType(2), TYPE_DECIMAL);
+  EXPECT_EQ(columns.GetOperand(2, 0).GetValue<DecimalP>(), DecimalP(std::string("-123.45")));
+  EXPECT_EQ(columns.GetOperand(2, 1).GetValue<DecimalP>(), DecimalP(std::string("1.00")));
+}
+
+TEST(ColumnBatchTest, Dictionary) {
+  int8_t codes[] = {0, 1, 0, 0, 1, 0};
+  Byte validity[] = {0x37};
+  int32_t values[] = {1, 2, 3, 4, 5, 6};
+  int32_t offsets[] = {0, 2, 6};
+  const char *data = "okfail";
+  int32_t swapped_offsets[] = {0, 4, 6};
+  const char *swapped_data = "failok";
+  const void *code_buffers[] = {validity, codes};
+  const void *value_buffers[] = {nullptr, values};
+  const void *dict_buffers[] = {nullptr, offsets, data};
+  struct ArrowSchema dict_schema = {"u", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowSchema code_schema = {"c", "", nullptr, 0, 0, nullptr, &dict_schema, ReleaseStatic, nullptr};
+  struct ArrowSchema value_schema = {"i", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowSchema *schema_children[] = {&code_schema, &value_schema};
+  struct ArrowSchema schema = {"+s", "", nullptr, 0, 2, schema_children, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray dict_array = {2, 0, 0, 3, 0, dict_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray code_array = {6, 1, 0, 2, 0, code_buffers, nullptr, &dict_array, ReleaseStatic, nullptr};
+  struct ArrowArray value_array = {6, 0, 0, 2, 0, value_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray *array_children[] = {&code_array, &value_array};
+  const void *buffers[] = {nullptr};
+  struct ArrowArray array = {6, 0, 0, 1, 2, buffers, array_children, nullptr, ReleaseStatic, nullptr};
+  {
+    ColumnBatch columns(&schema, &array);
+    EXPECT_TRUE(columns.IsDictionary(0));
+    EXPECT_FALSE(columns.IsDictionary(1));
+    EXPECT_EQ(columns.GetType(0), TYPE_STRING);
+    EXPECT_EQ(columns.GetDictionary(0), (std::vector<Operand>{"ok", "fail"}));
+    EXPECT_EQ(columns.GetCode(0, 1), 1);
+    EXPECT_EQ(columns.GetCode(0, 3), -1);
+    EXPECT_EQ(columns.GetOperand(0, 2), "ok");
+    EXPECT_EQ(columns.GetOperand(0, 3), nullptr);
+    std::vector<uint64_t> hashes(6, HASH_SEED);
+    columns.HashColumn(0, hashes.data());
+    EXPECT_EQ(hashes[1], HashValue(Tuple{"fail"}));
+    EXPECT_EQ(hashes[3], HashValue(Tuple{nullptr}));
+    // FILTER(input, $[0] == 'ok'), evaluated once per entry.
+    const auto *rel = MakeRunner("713700" "17026F6B" "910700");
+    Batch batch;
+    rel->Put(columns, batch);
+    EXPECT_EQ(batch.GetSelection(), (Selection{0, 2, 5}));
+    EXPECT_EQ(*batch.GetTuple(5), (Tuple{"ok", 6}));
+    EXPECT_EQ(rel->GetStats()[0].rows_in, 6);
+    EXPECT_EQ(rel->GetStats()[0].rows_out, 3);
+    delete rel;
+  }
+  // AGG(input, GROUP(0), COUNT(), SUM($[1])), grouped on codes stable across dictionaries.
+  const auto *rel = MakeRunner("7361010002102101");
+  Batch batch;
+  schema.release = ReleaseStatic;
+  array.release = ReleaseStatic;
+  {
+    ColumnBatch columns(&schema, &array);
+    rel->Put(columns, batch);
+  }
+  dict_buffers[1] = swapped_offsets;
+  dict_buffers[2] = swapped_data;
+  schema.release = ReleaseStatic;
+  array.release = ReleaseStatic;
+  {
+    ColumnBatch columns(&schema, &array);
+    rel->Put(columns, batch);
+  }
+  rel->PutTuple(std::make_unique<Tuple>(Tuple{"ok", 100}));
+  std::map<std::string, Tuple> groups;
+  for (TuplePtr tuple; (tuple = rel->GetTuple()) != nullptr;) {
+    const auto &key = (*tuple)[0];
+    groups[key == nullptr ? "" : std::string(key.GetValue<String>().View())] = *tuple;
+  }
+  ASSERT_EQ(groups.size(), 3);
+  EXPECT_EQ(groups["ok"], (Tuple{"ok", 6LL, 117}));
+  EXPECT_EQ(groups["fail"], (Tuple{"fail", 5LL, 17}));
+  EXPECT_EQ(groups[""], (Tuple{nullptr, 2LL, 8}));
+  delete rel;
+}
+
+TEST(ColumnBatchTest, DictionaryCodesOutOfRange) {
+  int8_t codes[] = {0, 2, 1};
+  uint64_t large_codes[] = {0, 1, 0x8000000000000000ULL};
+  Byte validity[] = {0x03};
+  int32_t offsets[] = {0, 2, 6};
+  const char *data = "okfail";
+  const void *code_buffers[] = {nullptr, codes};
+  const void *dict_buffers[] = {nullptr, offsets, data};
+  struct ArrowSchema dict_schema = {"u", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowSchema code_schema = {"c", "", nullptr, 0, 0, nullptr, &dict_schema, ReleaseStatic, nullptr};
+  struct ArrowSchema *schema_children[] = {&code_schema};
+  struct ArrowSchema schema = {"+s", "", nullptr, 0, 1, schema_children, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray dict_array = {2, 0, 0, 3, 0, dict_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+  struct ArrowArray code_array = {3, 0, 0, 2, 0, code_buffers, nullptr, &dict_array, ReleaseStatic, nullptr};
+  struct ArrowArray *array_children[] = {&code_array};
+  const void *buffers[] = {nullptr};
+  struct ArrowArray array = {3, 0, 0, 1, 1, buffers, array_children, nullptr, ReleaseStatic, nullptr};
+  EXPECT_THROW(ColumnBatch(&schema, &array), ExprError);
+  EXPECT_EQ(schema.release, nullptr);
+  EXPECT_EQ(array.release, nullptr);
+  // Unsigned 64-bit codes are not taken as negative, i.e. null.
+  code_schema.format = "L";
+  code_buffers[1] = large_codes;
+  schema.release = ReleaseStatic;
+  array.release = ReleaseStatic;
+  EXPECT_THROW(ColumnBatch(&schema, &array), ExprError);
+  // Codes of nulls are not checked.
+  code_buffers[0] = validity;
+  code_array.null_count = 1;
+  schema.release = ReleaseStatic;
+  array.release = ReleaseStatic;
+  ColumnBatch columns(&schema, &array);
+  EXPECT_EQ(columns.GetOperand(0, 0), "ok");
+  EXPECT_EQ(columns.GetOperand(0, 1), "fail");
+  EXPECT_EQ(columns.GetOperand(0, 2), nullptr);
+}
+
+TEST(ColumnBatchTest, HashColumns) {
+  struct ArrowSchema schema;
+  struct ArrowArray array;
+  MakeColumns(&schema, &array);
+  ColumnBatch columns(&schema, &array);
+  std::vector<uint64_t> hashes(columns.Size(), HASH_SEED);
+  for (size_t i = 0; i < columns.GetColumnCount(); ++i) {
+    columns.HashColumn(i, hashes.data());
+  }
+  std::vector<Tuple> tuples(columns.Size());
+  columns.ToTuples(tuples);
+  for (size_t j = 0; j < columns.Size(); ++j) {
+    EXPECT_EQ(hashes[j], HashValue(tuples[j]));
+  }
+}
+
+TEST(ColumnBatchTest, InputVars) {
+  // PROJECT(FILTER(input, $[2] > 50), $[0], $[1], $[2] / 10)
+  const auto *rel = MakeRunner("7134021442480000930400723100370134021441200000860400");
+  EXPECT_EQ(rel->GetInputVars(), (std::vector<VarInfo>{{2, TYPE_FLOAT}, {0, TYPE_INT32}, {1, TYPE_STRING}}));
+  delete rel;
+  // PROJECT(FILTER(input, $[2] > 50), $[1]), then column 0 is not decoded.
+  rel = MakeRunner("713402144248000093040072370100");
+  EXPECT_EQ(rel->GetInputVars(), (std::vector<VarInfo>{{2, TYPE_FLOAT}, {1, TYPE_STRING}}));
+  struct ArrowSchema schema;
+  struct ArrowArray array;
+  MakeColumns(&schema, &array);
+  ColumnBatch columns(&schema, &array);
+  Batch batch;
+  rel->Put(columns, batch);
+  ASSERT_EQ(batch.GetSelection().size(), 2);
+  EXPECT_EQ(*batch.GetTuple(0), (Tuple{nullptr}));
+  EXPECT_EQ(*batch.GetTuple(1), (Tuple{"Doris"}));
+  delete rel;
+  // FILTER(input, $[2] > 50), all the columns are output.
+  rel = MakeRunner("7134021442480000930400");
+  MakeColumns(&schema, &array);
+  ColumnBatch columns1(&schema, &array);
+  rel->Put(columns1, batch);
+  EXPECT_EQ(batch.GetSelection(), (Selection{1, 3}));
+  EXPECT_EQ(*batch.GetTuple(1), (Tuple{2, nullptr, 60.0f}));
+  delete rel;
+  // AGG(input, GROUP(1), COUNT(), SUM($[2]))
+  rel = MakeRunner("7361010102102402");
+  EXPECT_EQ(rel->GetInputVars(), (std::vector<VarInfo>{{1, TYPE_NULL}, {2, TYPE_NULL}}));
+  delete rel;
+}
+
+TEST(ColumnBatchTest, SelectByColumns) {
+  // FILTER(input, $[0] > 1 && $[2] < 70), evaluated over the columns.
+  const auto *rel = MakeRunner("71310011019301340214428C000095045200");
+  struct ArrowSchema schema;
+  struct ArrowArray array;
+  MakeColumns(&schema, &array);
+  ColumnBatch columns(&schema, &array);
+  Batch batch;
+  rel->Put(columns, batch);
+  EXPECT_EQ(batch.GetSelection(), (Selection{1}));
+  EXPECT_EQ(*batch.GetTuple(1), (Tuple{2, nullptr, 60.0f}));
+  auto stats = rel->GetStats();
+  EXPECT_EQ(stats[0].rows_in, 4);
+  EXPECT_EQ(stats[0].rows_out, 1);
+  delete rel;
+  // The same as evaluated on tuples, across words of the bitmaps and with nulls.
+  ColumnBatchBuilder builder({TYPE_INT32, TYPE_STRING, TYPE_FLOAT});
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < 200; ++i) {
+    tuples.push_back(Tuple{
+        i % 7 == 0 ? Operand(nullptr) : Operand(i % 5),
+        String("x"),
+        i % 11 == 0 ? Operand(nullptr) : Operand((float)(i % 100)),
+    });
+    builder.Append(tuples.back());
+  }
+  builder.Finish(&schema, &array);
+  ColumnBatch columns1(&schema, &array);
+  rel = MakeRunner("71310011019301340214428C000095045200");
+  rel->Put(columns1, batch);
+  const auto *expected = MakeRunner("71310011019301340214428C000095045200");
+  std::vector<const Tuple *> pointers;
+  for (const auto &tuple : tuples) {
+    pointers.push_back(&tuple);
+  }
+  Batch batch1(pointers.data(), pointers.size());
+  expected->Put(batch1);
+  EXPECT_FALSE(batch1.Empty());
+  EXPECT_EQ(batch.GetSelection(), batch1.GetSelection());
+  delete expected;
+  delete rel;
+}
@@ -0,0 +1,284 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expr/codec.h"
+#include "expr/utils.h"
+#include "rel/column_batch.h"
+#include "rel/parallel_runner.h"
+
+using namespace dingodb::expr;
+using namespace dingodb::rel;
+
+static void ReleaseStatic(struct ArrowArray *array) {
+  array->release = nullptr;
+}
+
+static void ReleaseStatic(struct ArrowSchema *schema) {
+  schema->release = nullptr;
+}
+
+// Arrow structures of two columns built by hand, which must outlive the batches imported.
+struct TwoColumns {
+  struct ArrowSchema schemas[2];
+  struct ArrowSchema *schema_children[2] = {&schemas[0], &schemas[1]};
+  struct ArrowArray arrays[2];
+  struct ArrowArray *array_children[2] = {&arrays[0], &arrays[1]};
+  const void *buffers[1] = {nullptr};
+
+  ColumnBatch *Import(int64_t length) {
+    struct ArrowSchema schema = {"+s", "", nullptr, 0, 2, schema_children, nullptr, ReleaseStatic, nullptr};
+    struct ArrowArray array = {length, 0, 0, 1, 2, buffers, array_children, nullptr, ReleaseStatic, nullptr};
+    return new ColumnBatch(&schema, &array);
+  }
+};
+
+class ParallelRunnerTest : public testing::Test {
+ protected:
+  static const int BATCHES = 64;
+  static const int ROWS = 100;
+
+  // Columns: int32 key, string name, int64 value, where the values are 0, 1, ... across the batches.
+  void SetUp() override {
+    for (int b = 0; b < BATCHES; ++b) {
+      ColumnBatchBuilder builder;
+      for (int r = 0; r < ROWS; ++r) {
+        int64_t value = b * ROWS + r;
+        int32_t key = static_cast<int32_t>(value % 7);
+        builder.Append(Tuple{key, String("k" + std::to_string(key)), value});
+      }
+      struct ArrowSchema schema;
+      struct ArrowArray array;
+      builder.Finish(&schema, &array);
+      m_columns.emplace_back(new ColumnBatch(&schema, &array));
+      m_inputs.push_back(m_columns.back().get());
+    }
+  }
+
+  static std::vector<Byte> ToBytes(const std::string &code) {
+    std::vector<Byte> buf(code.size() / 2);
+    HexToBytes(buf.data(), code.data(), code.size());
+    return buf;
+  }
+
+  static std::vector<Tuple> DrainAll(ParallelRunner &runner) {
+    std::vector<Tuple> result;
+    Batch batch;
+    for (runner.Drain(batch, 37); !batch.Empty(); runner.Drain(batch, 37)) {
+      for (auto i : batch.GetSelection()) {
+        result.push_back(*batch.GetTuple(i));
+      }
+    }
+    return result;
+  }
+
+  std::vector<std::unique_ptr<ColumnBatch>> m_columns;
+  std::vector<const ColumnBatch *> m_inputs;
+};
+
+TEST_F(ParallelRunnerTest, FilterInOrder) {
+  // FILTER(input, $[2] > 5000L)
+  auto code = ToBytes("713202128827930200");
+  ParallelRunner runner(4);
+  runner.Decode(code.data(), code.size());
+  EXPECT_EQ(runner.GetThreads(), 4);
+  runner.Put(m_inputs.data(), m_inputs.size());
+  auto result = DrainAll(runner);
+  ASSERT_EQ(result.size(), BATCHES * ROWS - 5001);
+  for (size_t i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(result[i][2], static_cast<int64_t>(5001 + i));
+  }
+  auto stats = runner.GetStats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].rows_in, BATCHES * ROWS);
+  EXPECT_EQ(stats[0].rows_out, result.size());
+}
+
+TEST_F(ParallelRunnerTest, GroupedAgg) {
+  // AGG(input, GROUP(1), COUNT(), SUM($[2]), MAX($[2]))
+  auto code = ToBytes("73610101031022023202");
+  ParallelRunner runner(4);
+  runner.Decode(code.data(), code.size());
+  // Put in two parts, merged all together.
+  runner.Put(m_inputs.data(), BATCHES / 2);
+  runner.Put(m_inputs.data() + BATCHES / 2, BATCHES / 2);
+  auto result = DrainAll(runner);
+  ASSERT_EQ(result.size(), 7);
+  std::map<std::string, Tuple> groups;
+  for (const auto &tuple : result) {
+    groups[std::string(tuple[0].GetValue<String>().View())] = tuple;
+  }
+  ASSERT_EQ(groups.size(), 7);
+  for (int k = 0; k < 7; ++k) {
+    int64_t count = 0;
+    int64_t sum = 0;
+    int64_t max = 0;
+    for (int64_t v = k; v < BATCHES * ROWS; v += 7) {
+      ++count;
+      sum += v;
+      max = v;
+    }
+    const auto &tuple = groups["k" + std::to_string(k)];
+    EXPECT_EQ(tuple[1], count);
+    EXPECT_EQ(tuple[2], sum);
+    EXPECT_EQ(tuple[3], max);
+  }
+  // The workers summed up, followed by the merging.
+  auto stats = runner.GetStats();
+  ASSERT_EQ(stats.size(), 2);
+  EXPECT_EQ(stats[0].rows_in, BATCHES * ROWS);
+  EXPECT_EQ(stats[1].rows_out, 7);
+}
+
+TEST_F(ParallelRunnerTest, AggThenProject) {
+  // PROJECT(AGG(input, COUNT(), SUM($[2])), $[0])
+  auto code = ToBytes("740210220272320000");
+  ParallelRunner runner(3);
+  runner.Decode(code.data(), code.size());
+  runner.Put(m_inputs.data(), m_inputs.size());
+  auto result = DrainAll(runner);
+  ASSERT_EQ(result.size(), 1);
+  EXPECT_EQ(result[0], (Tuple{static_cast<int64_t>(BATCHES * ROWS)}));
+}
+
+TEST_F(ParallelRunnerTest, DecimalSum) {
+  // Columns: int32 key, decimal(38, 2) value, where the values are 10^20 + 0, 1, ... + 0.25 across the batches.
+  static const __int128 BASE = static_cast<__int128>(100000000000LL) * 100000000000LL;
+  struct Data {
+    int32_t keys[ROWS];
+    __int128 values[ROWS];
+    const void *key_buffers[2];
+    const void *value_buffers[2];
+    TwoColumns columns;
+  };
+  std::vector<std::unique_ptr<Data>> data;
+  std::vector<std::unique_ptr<ColumnBatch>> columns;
+  std::vector<const ColumnBatch *> inputs;
+  for (int b = 0; b < BATCHES; ++b) {
+    auto *d = new Data;
+    data.emplace_back(d);
+    for (int r = 0; r < ROWS; ++r) {
+      int64_t value = b * ROWS + r;
+      d->keys[r] = static_cast<int32_t>(value % 7);
+      d->values[r] = BASE + value * 100 + 25;
+    }
+    d->key_buffers[0] = nullptr;
+    d->key_buffers[1] = d->keys;
+    d->value_buffers[0] = nullptr;
+    d->value_buffers[1] = d->values;
+    d->columns.schemas[0] = {"i", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+    d->columns.schemas[1] = {"d:38,2", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+    d->columns.arrays[0] = {ROWS, 0, 0, 2, 0, d->key_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+    d->columns.arrays[1] = {ROWS, 0, 0, 2, 0, d->value_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+    columns.emplace_back(d->columns.Import(ROWS));
+    inputs.push_back(columns.back().get());
+  }
+  // AGG(input, GROUP(0), SUM($[1])), the partial sums merged by `DecimalSumAgg::MergeAgg`.
+  auto code = ToBytes("73610100012601");
+  ParallelRunner runner(4);
+  runner.Decode(code.data(), code.size());
+  runner.Put(inputs.data(), BATCHES / 2);
+  runner.Put(inputs.data() + BATCHES / 2, BATCHES / 2);
+  auto result = DrainAll(runner);
+  ASSERT_EQ(result.size(), 7);
+  std::map<int32_t, Operand> sums;
+  for (const auto &tuple : result) {
+    sums[tuple[0].GetValue<int32_t>()] = tuple[1];
+  }
+  ASSERT_EQ(sums.size(), 7);
+  for (int k = 0; k < 7; ++k) {
+    __int128 sum = 0;
+    for (int64_t v = k; v < BATCHES * ROWS; v += 7) {
+      sum += BASE + v * 100 + 25;
+    }
+    EXPECT_EQ(sums[k].GetValue<DecimalP>(), DecimalP(Int128ToString(sum, 2)));
+  }
+}
+
+TEST_F(ParallelRunnerTest, DictionaryKeys) {
+  // Columns: dictionary-encoded string key, int64 value, where the entries of the dictionaries are in reversed order
+  // in the odd batches.
+  struct Data {
+    int8_t codes[ROWS];
+    int64_t values[ROWS];
+    int32_t offsets[8];
+    std::string entries;
+    const void *code_buffers[2];
+    const void *value_buffers[2];
+    const void *dict_buffers[3];
+    struct ArrowSchema dict_schema;
+    struct ArrowArray dict_array;
+    TwoColumns columns;
+  };
+  std::vector<std::unique_ptr<Data>> data;
+  std::vector<std::unique_ptr<ColumnBatch>> columns;
+  std::vector<const ColumnBatch *> inputs;
+  for (int b = 0; b < BATCHES; ++b) {
+    auto *d = new Data;
+    data.emplace_back(d);
+    auto entry = [b](int i) { return b % 2 == 0 ? i : 6 - i; };
+    d->offsets[0] = 0;
+    for (int i = 0; i < 7; ++i) {
+      d->entries += "k" + std::to_string(entry(i));
+      d->offsets[i + 1] = static_cast<int32_t>(d->entries.size());
+    }
+    for (int r = 0; r < ROWS; ++r) {
+      int64_t value = b * ROWS + r;
+      d->codes[r] = static_cast<int8_t>(entry(static_cast<int>(value % 7)));
+      d->values[r] = value;
+    }
+    d->code_buffers[0] = nullptr;
+    d->code_buffers[1] = d->codes;
+    d->value_buffers[0] = nullptr;
+    d->value_buffers[1] = d->values;
+    d->dict_buffers[0] = nullptr;
+    d->dict_buffers[1] = d->offsets;
+    d->dict_buffers[2] = d->entries.data();
+    d->dict_schema = {"u", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+    d->dict_array = {7, 0, 0, 3, 0, d->dict_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+    d->columns.schemas[0] = {"c", "", nullptr, 0, 0, nullptr, &d->dict_schema, ReleaseStatic, nullptr};
+    d->columns.schemas[1] = {"l", "", nullptr, 0, 0, nullptr, nullptr, ReleaseStatic, nullptr};
+    d->columns.arrays[0] = {ROWS, 0, 0, 2, 0, d->code_buffers, nullptr, &d->dict_array, ReleaseStatic, nullptr};
+    d->columns.arrays[1] = {ROWS, 0, 0, 2, 0, d->value_buffers, nullptr, nullptr, ReleaseStatic, nullptr};
+    columns.emplace_back(d->columns.Import(ROWS));
+    inputs.push_back(columns.back().get());
+  }
+  // AGG(input, GROUP(0), COUNT(), SUM($[1]))
+  auto code = ToBytes("7361010002102201");
+  ParallelRunner runner(4);
+  runner.Decode(code.data(), code.size());
+  runner.Put(inputs.data(), inputs.size());
+  auto result = DrainAll(runner);
+  ASSERT_EQ(result.size(), 7);
+  std::map<std::string, Tuple> groups;
+  for (const auto &tuple : result) {
+    groups[std::string(tuple[0].GetValue<String>().View())] = tuple;
+  }
+  ASSERT_EQ(groups.size(), 7);
+  for (int k = 0; k < 7; ++k) {
+    int64_t count = 0;
+    int64_t sum = 0;
+    for (int64_t v = k; v < BATCHES * ROWS; v += 7) {
+      ++count;
+      sum += v;
+    }
+    EXPECT_EQ(groups["k" + std::to_string(k)], (Tuple{String("k" + std::to_string(k)), count, sum}));
+  }
+}
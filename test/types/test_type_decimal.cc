@@ -15,6 +15,10 @@
 #include <gtest/gtest.h>
 #include "decimal.h"
 #include "decimal_p.h"
+#include "decimal_pool.h"
+
+#include <atomic>
+#include <thread>
 
 using namespace dingodb::types;
 
@@ -433,3 +437,67 @@ TEST(TestTypeDecimal, DecimalTest) {
 }
 
 
+
+// Memory functions of GMP set by the host, counting the allocations.
+static void *(*s_default_allocate)(size_t);
+static void *(*s_default_reallocate)(void *, size_t, size_t);
+static void (*s_default_free)(void *, size_t);
+static std::atomic<size_t> s_host_allocations(0);
+
+static void *HostAllocate(size_t size) {
+  ++s_host_allocations;
+  return s_default_allocate(size);
+}
+
+static void *HostReallocate(void *ptr, size_t old_size, size_t new_size) {
+  return s_default_reallocate(ptr, old_size, new_size);
+}
+
+static void HostFree(void *ptr, size_t size) {
+  s_default_free(ptr, size);
+}
+
+TEST(TestTypeDecimal, Pool) {
+  // The memory functions of GMP are replaced only if installed explicitly.
+  void *(*allocate)(size_t);
+  void *(*installed)(size_t);
+  mp_get_memory_functions(&allocate, nullptr, nullptr);
+  DecimalP c = DecimalP(std::string("1.5")) * DecimalP(std::string("2"));
+  mp_get_memory_functions(&installed, nullptr, nullptr);
+  ASSERT_EQ(installed, allocate);
+  // The host sets its own functions after decimals are created, which the pool draws from when installed.
+  mp_get_memory_functions(&s_default_allocate, &s_default_reallocate, &s_default_free);
+  mp_set_memory_functions(HostAllocate, HostReallocate, HostFree);
+  InstallDecimalPool();
+  InstallDecimalPool();
+  mp_get_memory_functions(&installed, nullptr, nullptr);
+  ASSERT_NE(installed, allocate);
+  ASSERT_NE(installed, HostAllocate);
+  size_t host_allocations = s_host_allocations;
+  {
+    // Too large to be pooled.
+    mpf_class large(1, 8192);
+  }
+  ASSERT_GT(s_host_allocations, host_allocations);
+  DecimalP a(std::string("1.25"));
+  DecimalP b(std::string("2.5"));
+  DecimalP sum = a + b;
+  for (int i = 0; i < 10; ++i) {
+    sum = sum + a * b;
+  }
+  auto before = GetDecimalPoolStats();
+  for (int i = 10; i < 1000; ++i) {
+    sum = sum + a * b;
+  }
+  auto after = GetDecimalPoolStats();
+  // In steady state, the temporaries and the results reuse the blocks freed before.
+  ASSERT_GT(after.hits, before.hits);
+  ASSERT_EQ(after.misses, before.misses);
+  ASSERT_EQ(sum.ToString(), DecimalP(std::string("3128.75")).ToString());
+  // Blocks may be freed by other threads.
+  std::thread([&sum]() {
+    DecimalP local = sum;
+    sum = DecimalP(std::string("0"));
+  }).join();
+  ASSERT_EQ(sum.ToString(), "0");
+}